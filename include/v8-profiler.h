@@ -711,6 +711,20 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot and streams it to |stream| in JSON format, without
+   * retaining it. Only the JSON serialization is moved off the pause: the
+   * snapshot graph is still built while the isolate is stopped, exactly as
+   * in TakeHeapSnapshot, and the complete graph is kept in memory until it
+   * has been written. The serialization runs on a background thread, so
+   * |stream| has to accept chunks from a thread other than the isolate's.
+   * The snapshot is released after EndOfStream() has been called or the
+   * stream has aborted. Returns false if the snapshot could not be taken.
+   */
+  bool TakeHeapSnapshotToStream(
+      OutputStream* stream, ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
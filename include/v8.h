@@ -551,6 +551,18 @@ template <class T> class PersistentBase {
                          typename WeakCallbackInfo<P>::Callback callback,
                          WeakCallbackType type);
 
+  /**
+   * Turns this handle into a weak phantom handle whose callbacks are batched.
+   * When the object dies, the garbage collector passes |parameter| along with
+   * the parameters of all other such handles whose objects died in the same
+   * garbage collection to the callback set with
+   * Isolate::SetBatchedWeakCallback, which has to be set before. Like after a
+   * phantom weak callback, the handle must not be used anymore and the
+   * embedder has to call Reset() on it.
+   */
+  template <typename P>
+  V8_INLINE void SetWeakBatched(P* parameter);
+
   /**
    * Turns this handle into a weak phantom handle without finalization callback.
    * The handle will be reset automatically when the garbage collector detects
@@ -1530,6 +1542,40 @@ class V8_EXPORT ScriptCompiler {
    */
   static uint32_t CachedDataVersionTag();
 
+  /**
+   * Creates a code cache for a script that has already run. Unlike the cache
+   * produced with kProduceCodeCache at compile time, it also contains the
+   * functions that were compiled lazily since, and it records which functions
+   * were optimized, so that these are optimized early again when the cache is
+   * consumed in another process.
+   *
+   * Returns nullptr if the script cannot be cached. The caller takes
+   * ownership of the returned data.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
+  /**
+   * Creates a feedback cache for a script that has already run. It contains
+   * the type feedback of the functions of the script that does not refer to
+   * objects, i.e. the operation hints, the call counts and the invocation
+   * counts, keyed by the source position of the functions.
+   *
+   * The caller takes ownership of the returned data.
+   */
+  static CachedData* CreateFeedbackCache(Local<UnboundScript> unbound_script,
+                                         Local<String> source);
+
+  /**
+   * Consumes a feedback cache created with CreateFeedbackCache for the same
+   * source. The functions of the script start out with the cached feedback
+   * when they are first compiled. Sets cached_data->rejected if the cache
+   * does not belong to the source or was created by another V8 version.
+   */
+  static void ConsumeFeedbackCache(Local<UnboundScript> unbound_script,
+                                   Local<String> source,
+                                   CachedData* cached_data);
+
   /**
    * This is an unfinished experimental feature, and is only exposed
    * here for internal testing purposes. DO NOT USE.
@@ -6467,6 +6513,24 @@ typedef void (*GCCallback)(GCType type, GCCallbackFlags flags);
 
 typedef void (*InterruptCallback)(Isolate* isolate, void* data);
 
+/**
+ * Callback of Isolate::SetHeapMemoryBudget. Invoked when the heap still uses
+ * more than |budget_bytes| after a full garbage collection, even though V8
+ * already released all the memory it could give up.
+ */
+typedef void (*HeapMemoryBudgetCallback)(Isolate* isolate, size_t used_bytes,
+                                         size_t budget_bytes, void* data);
+
+/**
+ * Callback of Isolate::SetBatchedWeakCallback. Receives the |parameters| of
+ * all handles made weak with PersistentBase::SetWeakBatched whose objects
+ * died in one garbage collection. The handles have to be reset with Reset(),
+ * which is the only call into V8 the callback may make, or later. Like first
+ * pass phantom callbacks, the callback must not call into V8 otherwise.
+ */
+typedef void (*BatchedWeakCallback)(Isolate* isolate, void* const* parameters,
+                                    size_t count, void* data);
+
 
 /**
  * Collection of V8 heap information.
@@ -6558,6 +6622,37 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Receives heap statistics records, see Isolate::SetHeapStatisticsStream.
+ *
+ * A record is emitted after every full garbage collection. It consists of
+ * unsigned LEB128 encoded integers:
+ *   - the record version (currently 1) and the garbage collection count,
+ *   - the number of object types, followed by the type index (see
+ *     Isolate::GetHeapObjectTypeName), the live object count and the live
+ *     bytes of each type,
+ *   - the number of allocation sites, followed by the id, the surviving object
+ *     count and the surviving bytes of each site, by decreasing bytes,
+ *   - the number of spaces, followed by the space index (see
+ *     Isolate::GetHeapSpaceStatistics), the committed, used and available
+ *     bytes of each space.
+ * Allocation sites are credited with the young generation objects allocated
+ * from them that survive until the garbage collection. Their ids are only
+ * stable until the next compacting garbage collection. In large heaps, the
+ * object counts and bytes of the old generation spaces are extrapolated from a
+ * sample of their pages.
+ */
+class V8_EXPORT HeapStatisticsStream {  // NOLINT
+ public:
+  virtual ~HeapStatisticsStream() {}
+
+  /**
+   * Called on the isolate's thread after a garbage collection. |data| is only
+   * valid during the call.
+   */
+  virtual void WriteRecord(const uint8_t* data, size_t size) = 0;
+};
+
 class RetainedObjectInfo;
 
 
@@ -7225,6 +7320,21 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Installs |stream| to receive a compact record of heap statistics after
+   * every full garbage collection, see HeapStatisticsStream. At most
+   * |max_allocation_sites| allocation sites are reported per record. Passing
+   * nullptr stops the records.
+   */
+  void SetHeapStatisticsStream(HeapStatisticsStream* stream,
+                               int max_allocation_sites = 16);
+
+  /**
+   * Returns the name of the object type with the given index, as used by
+   * HeapStatisticsStream records, or nullptr if the index is unknown.
+   */
+  const char* GetHeapObjectTypeName(size_t type_index);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -7619,6 +7729,52 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Optional notification to tell V8 the garbage collection latency the
+   * embedder expects. Incremental marking steps are kept below
+   * |target_pause_ms| and marking is started early enough for the mutator
+   * to keep |target_mutator_utilization| (a fraction between 0 and 1) of
+   * the time while the collector is active. A non-positive |target_pause_ms|
+   * restores the default heuristics.
+   * This is intended for embedders that never send idle notifications.
+   */
+  void SetGCLatencyTarget(double target_pause_ms,
+                          double target_mutator_utilization);
+
+  /**
+   * Sets a soft limit on the memory used by the heap of this isolate. Unlike
+   * the hard limit from ResourceConstraints, which crashes the process when
+   * it is reached, V8 degrades in stages as the heap size measured after
+   * full garbage collections approaches the budget:
+   * - it starts memory reducing garbage collections that compact more
+   *   aggressively,
+   * - it flushes the compilation cache and clears inline caches,
+   * - it deoptimizes all optimized code, so that the code can be freed,
+   * - it invokes |callback| once the budget is exceeded. The embedder is
+   *   expected to reject new work for the isolate, see
+   *   IsHeapMemoryBudgetExceeded.
+   * A |budget_bytes| of 0 removes the budget.
+   */
+  void SetHeapMemoryBudget(size_t budget_bytes,
+                           HeapMemoryBudgetCallback callback = nullptr,
+                           void* data = nullptr);
+
+  /**
+   * Returns true if the heap used more than the budget set with
+   * SetHeapMemoryBudget after the last full garbage collection.
+   */
+  bool IsHeapMemoryBudgetExceeded();
+
+  /**
+   * Sets the callback that receives the handles made weak with
+   * PersistentBase::SetWeakBatched whose objects died in a garbage
+   * collection. It is invoked at most once per garbage collection, instead of
+   * one weak callback per handle. The callback must not be nullptr, since the
+   * handles of dead objects stay allocated until the embedder resets them.
+   */
+  void SetBatchedWeakCallback(BatchedWeakCallback callback,
+                              void* data = nullptr);
+
   /**
    * Optional notification to tell V8 the current isolate is used for debugging
    * and requires higher heap limit.
@@ -8217,6 +8373,7 @@ class V8_EXPORT V8 {
                        int internal_field_index2,
                        WeakCallbackInfo<void>::Callback weak_callback);
   static void MakeWeak(internal::Object*** location_addr);
+  static void MakeWeakBatched(internal::Object** location, void* parameter);
   static void* ClearWeak(internal::Object** location);
   static Value* Eternalize(Isolate* isolate, Value* handle);
 
@@ -9358,6 +9515,13 @@ void PersistentBase<T>::SetWeak() {
   V8::MakeWeak(reinterpret_cast<internal::Object***>(&this->val_));
 }
 
+template <class T>
+template <typename P>
+void PersistentBase<T>::SetWeakBatched(P* parameter) {
+  V8::MakeWeakBatched(reinterpret_cast<internal::Object**>(this->val_),
+                      parameter);
+}
+
 template <class T>
 template <typename P>
 P* PersistentBase<T>::ClearWeak() {
@@ -106,7 +106,7 @@ class SerializerReference {
   bool is_valid() const { return bitfield_ != Special(kInvalidValue); }
 
   bool is_back_reference() const {
-    return SpaceBits::decode(bitfield_) <= LAST_SPACE;
+    return SpaceBits::decode(bitfield_) <= LO_SPACE;
   }
 
   AllocationSpace space() const {
@@ -181,7 +181,8 @@ class SerializerReference {
   static const int kChunkIndexSize = 32 - kChunkOffsetSize - kSpaceTagSize;
   static const int kValueIndexSize = kChunkOffsetSize + kChunkIndexSize;
 
-  static const int kSpecialValueSpace = LAST_SPACE + 1;
+  // Young large objects are serialized into the large object space.
+  static const int kSpecialValueSpace = LO_SPACE + 1;
   static const int kAttachedReferenceSpace = kSpecialValueSpace + 1;
   static const int kExternalSpace = kAttachedReferenceSpace + 1;
   STATIC_ASSERT(kExternalSpace < (1 << kSpaceTagSize));
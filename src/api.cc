@@ -39,10 +39,14 @@
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
 #include "src/execution.h"
+#include "src/feedback-profile.h"
 #include "src/frames-inl.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/globals.h"
+#include "src/heap/gc-latency-scheduler.h"
+#include "src/heap/heap-memory-budget.h"
+#include "src/heap/heap-statistics-recorder.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -988,6 +992,10 @@ void V8::MakeWeak(i::Object*** location_addr) {
   i::GlobalHandles::MakeWeak(location_addr);
 }
 
+void V8::MakeWeakBatched(i::Object** location, void* parameter) {
+  i::GlobalHandles::MakeWeakBatched(location, parameter);
+}
+
 void* V8::ClearWeak(i::Object** location) {
   return i::GlobalHandles::ClearWeakness(location);
 }
@@ -2648,6 +2656,69 @@ uint32_t ScriptCompiler::CachedDataVersionTag() {
       static_cast<uint32_t>(internal::CpuFeatures::SupportedFeatures())));
 }
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  i::HandleScope scope(isolate);
+  DCHECK(shared->is_toplevel());
+  i::Handle<i::Script> script(i::Script::cast(shared->script()), isolate);
+  // Don't try to produce any kind of cache when the debugger is loaded.
+  if (isolate->debug()->is_loaded() || script->ContainsAsmModule()) {
+    return nullptr;
+  }
+
+  i::HistogramTimerScope histogram_timer(
+      isolate->counters()->compile_serialize());
+  i::RuntimeCallTimerScope runtime_timer(
+      isolate, &i::RuntimeCallStats::CompileSerialize);
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.CompileSerialize");
+  i::ScriptData* script_data =
+      i::CodeSerializer::Serialize(isolate, shared, Utils::OpenHandle(*source));
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+ScriptCompiler::CachedData* ScriptCompiler::CreateFeedbackCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  i::HandleScope scope(isolate);
+  DCHECK(shared->is_toplevel());
+  i::Handle<i::Script> script(i::Script::cast(shared->script()), isolate);
+  i::ScriptData* script_data = i::FeedbackProfile::Serialize(
+      isolate, script, Utils::OpenHandle(*source));
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+void ScriptCompiler::ConsumeFeedbackCache(Local<UnboundScript> unbound_script,
+                                          Local<String> source,
+                                          CachedData* cached_data) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  i::HandleScope scope(isolate);
+  DCHECK(shared->is_toplevel());
+  i::Handle<i::Script> script(i::Script::cast(shared->script()), isolate);
+  i::ScriptData script_data(cached_data->data, cached_data->length);
+  if (!isolate->feedback_profile()->Register(
+          script, Utils::OpenHandle(*source), &script_data)) {
+    cached_data->rejected = true;
+  }
+}
+
 
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
@@ -8873,6 +8944,24 @@ bool Isolate::GetHeapObjectStatisticsAtLastGC(
   return true;
 }
 
+void Isolate::SetHeapStatisticsStream(HeapStatisticsStream* stream,
+                                      int max_allocation_sites) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->heap_statistics_recorder()->SetStream(stream,
+                                                         max_allocation_sites);
+}
+
+const char* Isolate::GetHeapObjectTypeName(size_t type_index) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  const char* object_type;
+  const char* object_sub_type;
+  if (!isolate->heap()->GetObjectTypeName(type_index, &object_type,
+                                          &object_sub_type)) {
+    return nullptr;
+  }
+  return object_type;
+}
+
 bool Isolate::GetHeapCodeAndMetadataStatistics(
     HeapCodeStatistics* code_statistics) {
   if (!code_statistics) return false;
@@ -9124,6 +9213,32 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetGCLatencyTarget(double target_pause_ms,
+                                 double target_mutator_utilization) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->gc_latency_scheduler()->SetTarget(
+      target_pause_ms, target_mutator_utilization);
+}
+
+void Isolate::SetHeapMemoryBudget(size_t budget_bytes,
+                                  HeapMemoryBudgetCallback callback,
+                                  void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->heap_memory_budget()->SetBudget(budget_bytes, callback,
+                                                   data);
+}
+
+bool Isolate::IsHeapMemoryBudgetExceeded() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  return isolate->heap()->heap_memory_budget()->exceeded();
+}
+
+void Isolate::SetBatchedWeakCallback(BatchedWeakCallback callback,
+                                     void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->global_handles()->SetBatchedWeakCallback(callback, data);
+}
+
 void Isolate::IncreaseHeapLimitForDebugging() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   isolate->heap()->IncreaseHeapLimitForDebugging();
@@ -10640,6 +10755,13 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
           ->TakeSnapshot(control, resolver));
 }
 
+bool HeapProfiler::TakeHeapSnapshotToStream(OutputStream* stream,
+                                            ActivityControl* control,
+                                            ObjectNameResolver* resolver) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->TakeSnapshotToStream(
+      stream, control, resolver);
+}
+
 
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
@@ -90,6 +90,15 @@ void AstRawString::Internalize(Isolate* isolate) {
   }
 }
 
+bool AstRawString::InternalizeFromEntry(Isolate* isolate, int entry) {
+  DCHECK(!has_string_);
+  AstRawStringInternalizationKey key(this);
+  String* string = StringTable::KeyAtEntryIfMatches(isolate, &key, entry);
+  if (string == nullptr) return false;
+  set_string(handle(string, isolate));
+  return true;
+}
+
 bool AstRawString::AsArrayIndex(uint32_t* index) const {
   // The StringHasher will set up the hash in such a way that we can use it to
   // figure out whether the string is convertible to an array index.
@@ -345,14 +354,47 @@ AstConsString* AstValueFactory::NewConsString(const AstRawString* str1,
   return NewConsString()->AddString(zone_, str1)->AddString(zone_, str2);
 }
 
+void AstValueFactory::PrepareForConcurrentLookup(Heap* heap) {
+  concurrent_lookup_heap_ = heap;
+}
+
+void AstValueFactory::LookupConcurrently() {
+  if (concurrent_lookup_heap_ == nullptr) return;
+  concurrent_lookup_results_ = new (zone_) ZoneVector<int>(zone_);
+  for (AstRawString* current = strings_; current != nullptr;
+       current = current->next()) {
+    int entry = StringTable::kNotFound;
+    if (!current->IsEmpty()) {
+      AstRawStringInternalizationKey key(current);
+      entry = StringTable::ConcurrentFindEntry(concurrent_lookup_heap_, &key);
+    }
+    concurrent_lookup_results_->push_back(entry);
+  }
+}
+
 void AstValueFactory::Internalize(Isolate* isolate) {
   // Strings need to be internalized before values, because values refer to
-  // strings.
-  for (AstRawString* current = strings_; current != nullptr;) {
+  // strings. Entries found by the concurrent lookups are only hints: the
+  // table may have been grown, or a GC may have cleared the entry, so they
+  // are confirmed against the current table here.
+  ZoneVector<int>* lookups = concurrent_lookup_results_;
+  size_t index = 0;
+  for (AstRawString* current = strings_; current != nullptr; index++) {
     AstRawString* next = current->next();
-    current->Internalize(isolate);
+    int entry = StringTable::kNotFound;
+    if (lookups != nullptr && index < lookups->size()) {
+      entry = lookups->at(index);
+    }
+    if (entry != StringTable::kNotFound &&
+        current->InternalizeFromEntry(isolate, entry)) {
+      concurrent_lookup_hits_++;
+    } else {
+      current->Internalize(isolate);
+    }
     current = next;
   }
+  concurrent_lookup_heap_ = nullptr;
+  concurrent_lookup_results_ = nullptr;
 
   // AstConsStrings refer to AstRawStrings.
   for (AstConsString* current = cons_strings_; current != nullptr;) {
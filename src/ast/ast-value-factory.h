@@ -34,6 +34,7 @@
 #include "src/globals.h"
 #include "src/isolate.h"
 #include "src/utils.h"
+#include "src/zone/zone-containers.h"
 
 // Ast(Raw|Cons)String, AstValue and AstValueFactory are for storing strings and
 // values independent of the V8 heap and internalizing them later. During
@@ -55,6 +56,9 @@ class AstRawString final : public ZoneObject {
   uint16_t FirstCharacter() const;
 
   void Internalize(Isolate* isolate);
+  // Takes the string at {entry} of the string table, as found by an earlier
+  // concurrent lookup, if it is still there. Returns false otherwise.
+  bool InternalizeFromEntry(Isolate* isolate, int entry);
 
   // Access the physical representation:
   bool is_one_byte() const { return is_one_byte_; }
@@ -385,7 +389,10 @@ class AstValueFactory {
         string_constants_(string_constants),
         empty_cons_string_(nullptr),
         zone_(zone),
-        hash_seed_(hash_seed) {
+        hash_seed_(hash_seed),
+        concurrent_lookup_heap_(nullptr),
+        concurrent_lookup_results_(nullptr),
+        concurrent_lookup_hits_(0) {
 #define F(name) name##_ = nullptr;
     OTHER_CONSTANTS(F)
 #undef F
@@ -417,6 +424,17 @@ class AstValueFactory {
 
   V8_EXPORT_PRIVATE void Internalize(Isolate* isolate);
 
+  // Strings that already exist in the isolate's string table can be resolved
+  // on the background parsing thread, leaving only the new ones for
+  // Internalize. PrepareForConcurrentLookup has to be called on the main
+  // thread before parsing starts; LookupConcurrently may then be called from
+  // the parsing thread. Internalize re-checks each string table entry that
+  // was found, so a GC or table growth in between only costs a lookup.
+  void PrepareForConcurrentLookup(Heap* heap);
+  void LookupConcurrently();
+  // Number of strings that Internalize took from the concurrent lookups.
+  int concurrent_lookup_hits() const { return concurrent_lookup_hits_; }
+
 #define F(name, str)                           \
   const AstRawString* name##_string() const {  \
     return string_constants_->name##_string(); \
@@ -494,6 +512,13 @@ class AstValueFactory {
 
   uint32_t hash_seed_;
 
+  // State of concurrent string table lookups. The results are string table
+  // entries in the order of {strings_}; kNotFound means the string has to be
+  // created.
+  Heap* concurrent_lookup_heap_;
+  ZoneVector<int>* concurrent_lookup_results_;
+  int concurrent_lookup_hits_;
+
 #define F(name) AstValue* name##_;
   OTHER_CONSTANTS(F)
 #undef F
@@ -57,6 +57,10 @@ BackgroundParsingTask::BackgroundParsingTask(
   source_->parser.reset(new Parser(source_->info.get()));
   source_->parser->DeserializeScopeChain(source_->info.get(),
                                          MaybeHandle<ScopeInfo>());
+  if (FLAG_concurrent_string_table_lookup) {
+    source_->info->ast_value_factory()->PrepareForConcurrentLookup(
+        isolate->heap());
+  }
 }
 
 void BackgroundParsingTask::Run() {
@@ -70,6 +74,7 @@ void BackgroundParsingTask::Run() {
   source_->parser->set_stack_limit(stack_limit);
 
   source_->parser->ParseOnBackground(source_->info.get());
+  source_->info->ast_value_factory()->LookupConcurrently();
 
   if (script_data_ != nullptr) {
     source_->cached_data.reset(new ScriptCompiler::CachedData(
@@ -148,6 +148,27 @@ void OS::Unprotect(void* address, const size_t size) {
 #endif
 }
 
+bool OS::AdviseHugePages(void* address, const size_t size) {
+#if defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+bool OS::DiscardSystemPages(void* address, const size_t size) {
+#if defined(MADV_FREE)
+  // MADV_FREE lets the kernel reclaim the pages only under memory pressure,
+  // which avoids the page faults on reuse. Older kernels reject it.
+  if (madvise(address, size, MADV_FREE) == 0) return true;
+#endif
+#if defined(MADV_DONTNEED)
+  return madvise(address, size, MADV_DONTNEED) == 0;
+#else
+  return posix_madvise(address, size, POSIX_MADV_DONTNEED) == 0;
+#endif
+}
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
@@ -831,6 +831,18 @@ void OS::Unprotect(void* address, const size_t size) {
   USE(result);
 }
 
+bool OS::AdviseHugePages(void* address, const size_t size) {
+  // Large pages on Windows require a privilege and cannot be applied to an
+  // existing reservation.
+  return false;
+}
+
+bool OS::DiscardSystemPages(void* address, const size_t size) {
+  // MEM_RESET keeps the pages committed but allows the system to drop their
+  // contents instead of writing them to the paging file.
+  return VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE) != nullptr;
+}
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
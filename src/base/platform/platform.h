@@ -191,6 +191,17 @@ class V8_BASE_EXPORT OS {
   // Make a region of memory readable and writable.
   static void Unprotect(void* address, const size_t size);
 
+  // Hint that a region of memory should be backed by transparent huge pages.
+  // Returns false if the hint is not supported on this platform.
+  static bool AdviseHugePages(void* address, const size_t size);
+
+  // Tell the OS that the contents of a committed region are no longer needed.
+  // The region stays accessible and the OS may reclaim the physical pages
+  // lazily. The contents are undefined afterwards: depending on the platform
+  // and on whether the pages were reclaimed, they read as zero or keep their
+  // old values. Returns false if the region could not be discarded.
+  static bool DiscardSystemPages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
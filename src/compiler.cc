@@ -504,6 +504,9 @@ void InsertCodeIntoOptimizedCodeCache(CompilationInfo* compilation_info) {
   Handle<Code> code = compilation_info->code();
   if (code->kind() != Code::OPTIMIZED_FUNCTION) return;  // Nothing to do.
 
+  // Remember that the function got hot, see SharedFunctionInfo::was_optimized.
+  compilation_info->shared_info()->set_was_optimized(true);
+
   // Function context specialization folds-in the function context,
   // so no sharing can occur.
   if (compilation_info->is_function_context_specializing()) {
@@ -1148,19 +1151,6 @@ MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
   return result;
 }
 
-namespace {
-
-bool ContainsAsmModule(Handle<Script> script) {
-  DisallowHeapAllocation no_gc;
-  SharedFunctionInfo::ScriptIterator iter(script);
-  while (SharedFunctionInfo* info = iter.Next()) {
-    if (info->HasAsmWasmData()) return true;
-  }
-  return false;
-}
-
-}  // namespace
-
 bool Compiler::CodeGenerationFromStringsAllowed(Isolate* isolate,
                                                 Handle<Context> context,
                                                 Handle<String> source) {
@@ -1340,7 +1330,7 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
                                    vector);
       if (FLAG_serialize_toplevel &&
           compile_options == ScriptCompiler::kProduceCodeCache &&
-          !ContainsAsmModule(script)) {
+          !script->ContainsAsmModule()) {
         HistogramTimerScope histogram_timer(
             isolate->counters()->compile_serialize());
         RuntimeCallTimerScope runtimeTimer(isolate,
@@ -161,7 +161,9 @@ Node* JSGraph::HeapConstant(Handle<HeapObject> value) {
 
 Node* JSGraph::Constant(Handle<Object> value) {
   // Dereference the handle to determine if a number constant or other
-  // canonicalized node can be used.
+  // canonicalized node can be used. This only reads immutable parts of the
+  // constant, which is safe off the main thread.
+  AllowHandleDereference allow_deref;
   if (value->IsNumber()) {
     return Constant(value->Number());
   } else if (value->IsUndefined(isolate())) {
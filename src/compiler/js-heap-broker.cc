@@ -0,0 +1,154 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/js-heap-broker.h"
+
+#include "src/code-factory.h"
+#include "src/compilation-dependencies.h"
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/objects-inl.h"
+#include "src/objects/module.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+JSHeapBroker::JSHeapBroker(Isolate* isolate, Zone* zone)
+    : isolate_(isolate),
+      functions_(zone),
+      global_proxies_(zone),
+      module_cells_(zone),
+      stable_maps_(zone),
+      string_add_stubs_(zone),
+      assumed_stable_maps_(zone) {}
+
+void JSHeapBroker::SerializeGraph(JSGraph* jsgraph, Zone* temp_zone) {
+  bool has_add = false;
+  AllNodes all(temp_zone, jsgraph->graph());
+  for (Node* node : all.reachable) {
+    switch (node->opcode()) {
+      case IrOpcode::kHeapConstant:
+        SerializeHeapConstant(OpParameter<Handle<HeapObject>>(node));
+        break;
+      case IrOpcode::kJSLoadModule:
+      case IrOpcode::kJSStoreModule: {
+        HeapObjectMatcher m(NodeProperties::GetValueInput(node, 0));
+        if (m.HasValue() && m.Value()->IsModule()) {
+          Handle<Module> module = Handle<Module>::cast(m.Value());
+          int32_t cell_index = OpParameter<int32_t>(node);
+          module_cells_[std::make_pair(module.address(), cell_index)] =
+              handle(module->GetCell(cell_index), isolate());
+        }
+        break;
+      }
+      case IrOpcode::kJSAdd:
+        has_add = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (has_add) {
+    for (StringAddFlags flags :
+         {STRING_ADD_CHECK_NONE, STRING_ADD_CONVERT_LEFT,
+          STRING_ADD_CONVERT_RIGHT}) {
+      string_add_stubs_[flags] =
+          CodeFactory::StringAdd(isolate(), flags, NOT_TENURED).code();
+    }
+  }
+
+  // Calls to CPP and API builtins are lowered to these stubs.
+  jsgraph->CEntryStubConstant(1, kDontSaveFPRegs, kArgvOnStack, true);
+  jsgraph->CEntryStubConstant(1, kDontSaveFPRegs, kArgvOnStack, false);
+}
+
+void JSHeapBroker::SerializeHeapConstant(Handle<HeapObject> object) {
+  Address key = object.address();
+  if (object->map()->is_stable()) {
+    stable_maps_[key] = handle(object->map(), isolate());
+  }
+  FunctionData data;
+  if (ReadFunctionData(object, &data)) {
+    functions_[key] = data;
+  } else if (object->IsContext()) {
+    global_proxies_[key] =
+        handle(Handle<Context>::cast(object)->global_proxy(), isolate());
+  }
+}
+
+// static
+bool JSHeapBroker::ReadFunctionData(Handle<HeapObject> object,
+                                    FunctionData* data) {
+  if (!object->IsJSFunction()) return false;
+  SharedFunctionInfo* shared = Handle<JSFunction>::cast(object)->shared();
+  data->construct_stub = handle(shared->construct_stub());
+  data->code_builtin_index = shared->code()->builtin_index();
+  data->construct_stub_builtin_index =
+      data->construct_stub->builtin_index();
+  data->formal_parameter_count = shared->internal_formal_parameter_count();
+  data->kind = shared->kind();
+  data->language_mode = shared->language_mode();
+  data->native = shared->native();
+  data->builtin_function_id = shared->HasBuiltinFunctionId()
+                                  ? shared->builtin_function_id()
+                                  : kInvalidBuiltinFunctionId;
+  return true;
+}
+
+bool JSHeapBroker::GetFunctionData(Handle<HeapObject> object,
+                                   FunctionData* data) const {
+  auto it = functions_.find(object.address());
+  if (it == functions_.end()) return false;
+  *data = it->second;
+  return true;
+}
+
+MaybeHandle<JSObject> JSHeapBroker::GetGlobalProxy(
+    Handle<Context> context) const {
+  auto it = global_proxies_.find(context.address());
+  if (it == global_proxies_.end()) return MaybeHandle<JSObject>();
+  return it->second;
+}
+
+MaybeHandle<Cell> JSHeapBroker::GetModuleCell(Handle<Module> module,
+                                              int cell_index) const {
+  auto it = module_cells_.find(std::make_pair(module.address(), cell_index));
+  if (it == module_cells_.end()) return MaybeHandle<Cell>();
+  return it->second;
+}
+
+MaybeHandle<Code> JSHeapBroker::GetStringAddStub(StringAddFlags flags) const {
+  auto it = string_add_stubs_.find(flags);
+  if (it == string_add_stubs_.end()) return MaybeHandle<Code>();
+  return it->second;
+}
+
+MaybeHandle<Map> JSHeapBroker::GetStableMap(Handle<HeapObject> object) const {
+  auto it = stable_maps_.find(object.address());
+  if (it == stable_maps_.end()) return MaybeHandle<Map>();
+  return it->second;
+}
+
+void JSHeapBroker::AssumeMapStable(Handle<Map> map) {
+  assumed_stable_maps_.push_back(map);
+}
+
+bool JSHeapBroker::CommitDependencies(
+    CompilationDependencies* dependencies) const {
+  for (Handle<Map> map : assumed_stable_maps_) {
+    if (!map->is_stable()) return false;
+  }
+  for (Handle<Map> map : assumed_stable_maps_) {
+    dependencies->AssumeMapStable(map);
+  }
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
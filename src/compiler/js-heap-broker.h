@@ -0,0 +1,106 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_JS_HEAP_BROKER_H_
+#define V8_COMPILER_JS_HEAP_BROKER_H_
+
+#include <utility>
+
+#include "src/base/compiler-specific.h"
+#include "src/globals.h"
+#include "src/handles.h"
+#include "src/objects.h"
+#include "src/type-hints.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+
+// Forward declarations.
+class Cell;
+class CompilationDependencies;
+class Module;
+
+namespace compiler {
+
+// Forward declarations.
+class JSGraph;
+
+// The broker lets the typer and the typed lowering run on the background
+// thread with --concurrent-typed-lowering. Right before the job is handed to
+// the dispatcher it walks the graph on the main thread and snapshots the
+// handles that these phases would otherwise have to create themselves. The
+// reducers ask the broker instead and skip a reduction if it has no answer,
+// e.g. for constants that only appeared after the serialization.
+//
+// Constants are identified by the location of their handle, which is unique
+// per object because the pipeline allocates handles canonically.
+class V8_EXPORT_PRIVATE JSHeapBroker : public NON_EXPORTED_BASE(ZoneObject) {
+ public:
+  JSHeapBroker(Isolate* isolate, Zone* zone);
+
+  // Records the data of the heap constants in the graph and creates the
+  // code stubs that the typed lowering may embed. Main thread only.
+  void SerializeGraph(JSGraph* jsgraph, Zone* temp_zone);
+
+  // The parts of a function constant that the typer and the typed lowering
+  // look at.
+  struct FunctionData {
+    Handle<Code> construct_stub;
+    int code_builtin_index;  // Of the SharedFunctionInfo's code, or -1.
+    int construct_stub_builtin_index;
+    int formal_parameter_count;
+    FunctionKind kind;
+    LanguageMode language_mode;
+    bool native;
+    BuiltinFunctionId builtin_function_id;  // Or kInvalidBuiltinFunctionId.
+  };
+
+  // Reads the data of {object} from the heap. Returns false if {object} is
+  // not a JSFunction. Main thread only.
+  static bool ReadFunctionData(Handle<HeapObject> object, FunctionData* data);
+
+  // Returns false if {object} is not a JSFunction that was serialized. Safe to
+  // use on the background thread.
+  bool GetFunctionData(Handle<HeapObject> object, FunctionData* data) const;
+
+  // The accessors below return an empty handle if the object was not
+  // serialized. They are safe to use on the background thread.
+  MaybeHandle<JSObject> GetGlobalProxy(Handle<Context> context) const;
+  MaybeHandle<Cell> GetModuleCell(Handle<Module> module, int cell_index) const;
+  MaybeHandle<Code> GetStringAddStub(StringAddFlags flags) const;
+
+  // Returns the map of {object} if it was stable when the graph was
+  // serialized.
+  MaybeHandle<Map> GetStableMap(Handle<HeapObject> object) const;
+
+  // Code dependencies cannot be installed off the main thread, so the
+  // stability assumptions are collected and committed when the job is
+  // finalized. Stability is never regained, so a map that is still stable at
+  // that point did not transition in between.
+  void AssumeMapStable(Handle<Map> map);
+  // Returns false if one of the assumed maps is no longer stable.
+  bool CommitDependencies(CompilationDependencies* dependencies) const;
+
+ private:
+  void SerializeHeapConstant(Handle<HeapObject> object);
+
+  Isolate* isolate() const { return isolate_; }
+
+  Isolate* const isolate_;
+  ZoneMap<Address, FunctionData> functions_;
+  ZoneMap<Address, Handle<JSObject>> global_proxies_;
+  ZoneMap<std::pair<Address, int>, Handle<Cell>> module_cells_;
+  ZoneMap<Address, Handle<Map>> stable_maps_;
+  ZoneMap<int, Handle<Code>> string_add_stubs_;
+  ZoneVector<Handle<Map>> assumed_stable_maps_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSHeapBroker);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_JS_HEAP_BROKER_H_
@@ -9,6 +9,7 @@
 #include "src/code-factory.h"
 #include "src/compiler/access-builder.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/js-heap-broker.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
@@ -87,6 +88,9 @@ class JSBinopReduction final {
   bool ShouldCreateConsString() {
     DCHECK_EQ(IrOpcode::kJSAdd, node_->opcode());
     DCHECK(OneInputIs(Type::String()));
+    // Constant strings can be externalized concurrently, so their
+    // representation is not inspected off the main thread.
+    if (lowering_->broker() != nullptr) return false;
     if (BothInputsAre(Type::String()) ||
         BinaryOperationHintOf(node_->op()) == BinaryOperationHint::kString) {
       HeapObjectBinopMatcher m(node_);
@@ -397,10 +401,11 @@ class JSBinopReduction final {
 // - immediately put in type bounds for all new nodes
 // - relax effects from generic but not-side-effecting operations
 
-JSTypedLowering::JSTypedLowering(Editor* editor,
-                                 JSGraph* jsgraph, Zone* zone)
+JSTypedLowering::JSTypedLowering(Editor* editor, JSGraph* jsgraph,
+                                 JSHeapBroker* broker, Zone* zone)
     : AdvancedReducer(editor),
       jsgraph_(jsgraph),
+      broker_(broker),
       empty_string_type_(
           Type::HeapConstant(factory()->empty_string(), graph()->zone())),
       pointer_comparable_type_(
@@ -452,8 +457,9 @@ Reduction JSTypedLowering::ReduceJSAdd(Node* node) {
         NodeProperties::ReplaceValueInput(node, reduction.replacement(), 0);
       }
     }
-    // We might be able to constant-fold the String concatenation now.
-    if (r.BothInputsAre(Type::String())) {
+    // We might be able to constant-fold the String concatenation now. This
+    // allocates the result, so it is not done off the main thread.
+    if (r.BothInputsAre(Type::String()) && broker() == nullptr) {
       HeapObjectBinopMatcher m(node);
       if (m.IsFoldable()) {
         Handle<String> left = Handle<String>::cast(m.left().Value());
@@ -503,14 +509,18 @@ Reduction JSTypedLowering::ReduceJSAdd(Node* node) {
     }
     // JSAdd(x:string, y) => CallStub[StringAdd](x, y)
     // JSAdd(x, y:string) => CallStub[StringAdd](x, y)
-    Callable const callable =
-        CodeFactory::StringAdd(isolate(), flags, NOT_TENURED);
+    Handle<Code> code;
+    if (broker() == nullptr) {
+      code = CodeFactory::StringAdd(isolate(), flags, NOT_TENURED).code();
+    } else if (!broker()->GetStringAddStub(flags).ToHandle(&code)) {
+      return NoChange();
+    }
+    Callable const callable(code, StringAddDescriptor(isolate()));
     CallDescriptor const* const desc = Linkage::GetStubCallDescriptor(
         isolate(), graph()->zone(), callable.descriptor(), 0,
         CallDescriptor::kNeedsFrameState, properties);
     DCHECK_EQ(1, OperatorProperties::GetFrameStateInputCount(node->op()));
-    node->InsertInput(graph()->zone(), 0,
-                      jsgraph()->HeapConstant(callable.code()));
+    node->InsertInput(graph()->zone(), 0, jsgraph()->HeapConstant(code));
     NodeProperties::ChangeOp(node, common()->Call(desc));
     return Changed(node);
   }
@@ -781,7 +791,9 @@ Reduction JSTypedLowering::ReduceJSTypeOf(Node* node) {
     return Replace(jsgraph()->Constant(f->object_string()));
   } else if (type->Is(Type::Function())) {
     return Replace(jsgraph()->Constant(f->function_string()));
-  } else if (type->IsHeapConstant()) {
+  } else if (type->IsHeapConstant() && broker() == nullptr) {
+    // Object::TypeOf reads the constant's map, which is not safe off the main
+    // thread.
     return Replace(jsgraph()->Constant(
         Object::TypeOf(isolate(), type->AsHeapConstant()->Value())));
   }
@@ -987,9 +999,10 @@ Reduction JSTypedLowering::ReduceJSToLength(Node* node) {
 }
 
 Reduction JSTypedLowering::ReduceJSToNumberInput(Node* input) {
-  // Try constant-folding of JSToNumber with constant inputs.
+  // Try constant-folding of JSToNumber with constant inputs. Strings might
+  // have to be flattened, which is not possible off the main thread.
   Type* input_type = NodeProperties::GetType(input);
-  if (input_type->Is(Type::String())) {
+  if (input_type->Is(Type::String()) && broker() == nullptr) {
     HeapObjectMatcher m(input);
     if (m.HasValue() && m.Value()->IsString()) {
       Handle<Object> input_value = m.Value();
@@ -997,12 +1010,13 @@ Reduction JSTypedLowering::ReduceJSToNumberInput(Node* input) {
           String::ToNumber(Handle<String>::cast(input_value))));
     }
   }
-  if (input_type->IsHeapConstant()) {
+  if (input_type->IsHeapConstant() && input_type->Is(Type::Oddball())) {
+    // Oddballs are immortal immovable roots, and their number value never
+    // changes, so reading it is fine off the main thread.
+    AllowHandleDereference allow_deref;
     Handle<Object> input_value = input_type->AsHeapConstant()->Value();
-    if (input_value->IsOddball()) {
-      return Replace(jsgraph()->Constant(
-          Oddball::ToNumber(Handle<Oddball>::cast(input_value))));
-    }
+    return Replace(jsgraph()->Constant(
+        Handle<Oddball>::cast(input_value)->to_number_raw()));
   }
   if (input_type->Is(Type::Number())) {
     // JSToNumber(x:number) => x
@@ -1064,9 +1078,10 @@ Reduction JSTypedLowering::ReduceJSToStringInput(Node* input) {
     return Replace(jsgraph()->HeapConstant(factory()->NaN_string()));
   }
   if (input_type->Is(Type::OrderedNumber()) &&
-      input_type->Min() == input_type->Max()) {
+      input_type->Min() == input_type->Max() && broker() == nullptr) {
     // Note that we can use Type::OrderedNumber(), since
-    // both 0 and -0 map to the String "0" in JavaScript.
+    // both 0 and -0 map to the String "0" in JavaScript. The string is
+    // allocated, so this is not done off the main thread.
     return Replace(jsgraph()->HeapConstant(
         factory()->NumberToString(factory()->NewNumber(input_type->Min()))));
   }
@@ -1391,8 +1406,16 @@ Node* JSTypedLowering::BuildGetModuleCell(Node* node) {
   if (module_type->IsHeapConstant()) {
     Handle<Module> module_constant =
         Handle<Module>::cast(module_type->AsHeapConstant()->Value());
-    Handle<Cell> cell_constant(module_constant->GetCell(cell_index), isolate());
-    return jsgraph()->HeapConstant(cell_constant);
+    if (broker() == nullptr) {
+      Handle<Cell> cell_constant(module_constant->GetCell(cell_index),
+                                 isolate());
+      return jsgraph()->HeapConstant(cell_constant);
+    }
+    Handle<Cell> cell_constant;
+    if (broker()->GetModuleCell(module_constant, cell_index)
+            .ToHandle(&cell_constant)) {
+      return jsgraph()->HeapConstant(cell_constant);
+    }
   }
 
   FieldAccess field_access;
@@ -1447,6 +1470,14 @@ Reduction JSTypedLowering::ReduceJSStoreModule(Node* node) {
   return Changed(value);
 }
 
+MaybeHandle<JSObject> JSTypedLowering::GetGlobalProxy(Type* context_type) {
+  if (!context_type->IsHeapConstant()) return MaybeHandle<JSObject>();
+  Handle<Context> context =
+      Handle<Context>::cast(context_type->AsHeapConstant()->Value());
+  if (broker() != nullptr) return broker()->GetGlobalProxy(context);
+  return handle(context->global_proxy(), isolate());
+}
+
 Reduction JSTypedLowering::ReduceJSConvertReceiver(Node* node) {
   DCHECK_EQ(IrOpcode::kJSConvertReceiver, node->opcode());
   ConvertReceiverMode mode = ConvertReceiverModeOf(node->op());
@@ -1467,11 +1498,8 @@ Reduction JSTypedLowering::ReduceJSConvertReceiver(Node* node) {
   // with the global proxy unconditionally.
   if (receiver_type->Is(Type::NullOrUndefined()) ||
       mode == ConvertReceiverMode::kNullOrUndefined) {
-    if (context_type->IsHeapConstant()) {
-      Handle<JSObject> global_proxy(
-          Handle<Context>::cast(context_type->AsHeapConstant()->Value())
-              ->global_proxy(),
-          isolate());
+    Handle<JSObject> global_proxy;
+    if (GetGlobalProxy(context_type).ToHandle(&global_proxy)) {
       receiver = jsgraph()->Constant(global_proxy);
     } else {
       Node* native_context = effect = graph()->NewNode(
@@ -1574,11 +1602,8 @@ Reduction JSTypedLowering::ReduceJSConvertReceiver(Node* node) {
   Node* eglobal = effect;
   Node* rglobal;
   {
-    if (context_type->IsHeapConstant()) {
-      Handle<JSObject> global_proxy(
-          Handle<Context>::cast(context_type->AsHeapConstant()->Value())
-              ->global_proxy(),
-          isolate());
+    Handle<JSObject> global_proxy;
+    if (GetGlobalProxy(context_type).ToHandle(&global_proxy)) {
       rglobal = jsgraph()->Constant(global_proxy);
     } else {
       Node* native_context = eglobal = graph()->NewNode(
@@ -1680,12 +1705,23 @@ void ReduceBuiltin(Isolate* isolate, JSGraph* jsgraph, Node* node,
   NodeProperties::ChangeOp(node, jsgraph->common()->Call(desc));
 }
 
-bool NeedsArgumentAdaptorFrame(Handle<SharedFunctionInfo> shared, int arity) {
+bool NeedsArgumentAdaptorFrame(const JSHeapBroker::FunctionData& function,
+                               int arity) {
   static const int sentinel = SharedFunctionInfo::kDontAdaptArgumentsSentinel;
-  const int num_decl_parms = shared->internal_formal_parameter_count();
+  const int num_decl_parms = function.formal_parameter_count;
   return (num_decl_parms != arity && num_decl_parms != sentinel);
 }
 
+// Returns false if {type} is not a known JSFunction constant. Off the main
+// thread only the functions serialized by the {broker} are known.
+bool GetFunctionData(JSHeapBroker* broker, Type* type,
+                     JSHeapBroker::FunctionData* data) {
+  if (!type->IsHeapConstant()) return false;
+  Handle<HeapObject> object = type->AsHeapConstant()->Value();
+  if (broker != nullptr) return broker->GetFunctionData(object, data);
+  return JSHeapBroker::ReadFunctionData(object, data);
+}
+
 }  // namespace
 
 Reduction JSTypedLowering::ReduceJSConstructForwardVarargs(Node* node) {
@@ -1732,18 +1768,16 @@ Reduction JSTypedLowering::ReduceJSConstruct(Node* node) {
   Node* control = NodeProperties::GetControlInput(node);
 
   // Check if {target} is a known JSFunction.
-  if (target_type->IsHeapConstant() &&
-      target_type->AsHeapConstant()->Value()->IsJSFunction()) {
-    Handle<JSFunction> function =
-        Handle<JSFunction>::cast(target_type->AsHeapConstant()->Value());
-    Handle<SharedFunctionInfo> shared(function->shared(), isolate());
-    const int builtin_index = shared->construct_stub()->builtin_index();
+  JSHeapBroker::FunctionData function;
+  if (GetFunctionData(broker(), target_type, &function)) {
+    Handle<Code> construct_stub = function.construct_stub;
+    const int builtin_index = function.construct_stub_builtin_index;
     const bool is_builtin = (builtin_index != -1);
 
     CallDescriptor::Flags flags = CallDescriptor::kNeedsFrameState;
 
     if (is_builtin && Builtins::HasCppImplementation(builtin_index) &&
-        !NeedsArgumentAdaptorFrame(shared, arity)) {
+        !NeedsArgumentAdaptorFrame(function, arity)) {
       // Patch {node} to a direct CEntryStub call.
 
       // Load the context from the {target}.
@@ -1758,8 +1792,7 @@ Reduction JSTypedLowering::ReduceJSConstruct(Node* node) {
       ReduceBuiltin(isolate(), jsgraph(), node, builtin_index, arity, flags);
     } else {
       // Patch {node} to an indirect call via the {function}s construct stub.
-      Callable callable(handle(shared->construct_stub(), isolate()),
-                        ConstructStubDescriptor(isolate()));
+      Callable callable(construct_stub, ConstructStubDescriptor(isolate()));
       node->RemoveInput(arity + 1);
       node->InsertInput(graph()->zone(), 0,
                         jsgraph()->HeapConstant(callable.code()));
@@ -1844,17 +1877,14 @@ Reduction JSTypedLowering::ReduceJSCall(Node* node) {
   }
 
   // Check if {target} is a known JSFunction.
-  if (target_type->IsHeapConstant() &&
-      target_type->AsHeapConstant()->Value()->IsJSFunction()) {
-    Handle<JSFunction> function =
-        Handle<JSFunction>::cast(target_type->AsHeapConstant()->Value());
-    Handle<SharedFunctionInfo> shared(function->shared(), isolate());
-    const int builtin_index = shared->code()->builtin_index();
+  JSHeapBroker::FunctionData function;
+  if (GetFunctionData(broker(), target_type, &function)) {
+    const int builtin_index = function.code_builtin_index;
     const bool is_builtin = (builtin_index != -1);
 
     // Class constructors are callable, but [[Call]] will raise an exception.
     // See ES6 section 9.2.1 [[Call]] ( thisArgument, argumentsList ).
-    if (IsClassConstructor(shared->kind())) return NoChange();
+    if (IsClassConstructor(function.kind)) return NoChange();
 
     // Load the context from the {target}.
     Node* context = effect = graph()->NewNode(
@@ -1863,7 +1893,7 @@ Reduction JSTypedLowering::ReduceJSCall(Node* node) {
     NodeProperties::ReplaceContextInput(node, context);
 
     // Check if we need to convert the {receiver}.
-    if (is_sloppy(shared->language_mode()) && !shared->native() &&
+    if (is_sloppy(function.language_mode) && !function.native &&
         !receiver_type->Is(Type::Receiver())) {
       receiver = effect =
           graph()->NewNode(javascript()->ConvertReceiver(convert_mode),
@@ -1878,7 +1908,7 @@ Reduction JSTypedLowering::ReduceJSCall(Node* node) {
     CallDescriptor::Flags flags = CallDescriptor::kNeedsFrameState;
     Node* new_target = jsgraph()->UndefinedConstant();
     Node* argument_count = jsgraph()->Constant(arity);
-    if (NeedsArgumentAdaptorFrame(shared, arity)) {
+    if (NeedsArgumentAdaptorFrame(function, arity)) {
       // Patch {node} to an indirect call via the ArgumentsAdaptorTrampoline.
       Callable callable = CodeFactory::ArgumentAdaptor(isolate());
       node->InsertInput(graph()->zone(), 0,
@@ -1887,7 +1917,7 @@ Reduction JSTypedLowering::ReduceJSCall(Node* node) {
       node->InsertInput(graph()->zone(), 3, argument_count);
       node->InsertInput(
           graph()->zone(), 4,
-          jsgraph()->Constant(shared->internal_formal_parameter_count()));
+          jsgraph()->Constant(function.formal_parameter_count));
       NodeProperties::ChangeOp(
           node, common()->Call(Linkage::GetStubCallDescriptor(
                     isolate(), graph()->zone(), callable.descriptor(),
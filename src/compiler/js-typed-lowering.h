@@ -21,15 +21,19 @@ namespace compiler {
 // Forward declarations.
 class CommonOperatorBuilder;
 class JSGraph;
+class JSHeapBroker;
 class JSOperatorBuilder;
 class SimplifiedOperatorBuilder;
 class TypeCache;
 
-// Lowers JS-level operators to simplified operators based on types.
+// Lowers JS-level operators to simplified operators based on types. With a
+// {broker} the reducer runs off the main thread and takes the heap data it
+// would otherwise have to allocate handles for from the broker.
 class V8_EXPORT_PRIVATE JSTypedLowering final
     : public NON_EXPORTED_BASE(AdvancedReducer) {
  public:
-  JSTypedLowering(Editor* editor, JSGraph* jsgraph, Zone* zone);
+  JSTypedLowering(Editor* editor, JSGraph* jsgraph, JSHeapBroker* broker,
+                  Zone* zone);
   ~JSTypedLowering() final {}
 
   const char* reducer_name() const override { return "JSTypedLowering"; }
@@ -84,18 +88,23 @@ class V8_EXPORT_PRIVATE JSTypedLowering final
   // Helper for ReduceJSLoadModule and ReduceJSStoreModule.
   Node* BuildGetModuleCell(Node* node);
 
+  // Helper for ReduceJSConvertReceiver.
+  MaybeHandle<JSObject> GetGlobalProxy(Type* context_type);
+
   // Helpers for ReduceJSCreateConsString and ReduceJSStringConcat.
   Node* BuildGetStringLength(Node* value, Node** effect, Node* control);
 
   Factory* factory() const;
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
+  JSHeapBroker* broker() const { return broker_; }
   Isolate* isolate() const;
   JSOperatorBuilder* javascript() const;
   CommonOperatorBuilder* common() const;
   SimplifiedOperatorBuilder* simplified() const;
 
   JSGraph* jsgraph_;
+  JSHeapBroker* broker_;
   Type* empty_string_type_;
   Type* pointer_comparable_type_;
   TypeCache const& type_cache_;
@@ -362,8 +362,9 @@ void MemoryOptimizer::VisitStoreElement(Node* node,
   ElementAccess const& access = ElementAccessOf(node->op());
   Node* object = node->InputAt(0);
   Node* index = node->InputAt(1);
+  Node* value = node->InputAt(2);
   WriteBarrierKind write_barrier_kind =
-      ComputeWriteBarrierKind(object, state, access.write_barrier_kind);
+      ComputeWriteBarrierKind(object, value, state, access.write_barrier_kind);
   node->ReplaceInput(1, ComputeIndex(access, index));
   NodeProperties::ChangeOp(
       node, machine()->Store(StoreRepresentation(
@@ -376,8 +377,9 @@ void MemoryOptimizer::VisitStoreField(Node* node,
   DCHECK_EQ(IrOpcode::kStoreField, node->opcode());
   FieldAccess const& access = FieldAccessOf(node->op());
   Node* object = node->InputAt(0);
+  Node* value = node->InputAt(1);
   WriteBarrierKind write_barrier_kind =
-      ComputeWriteBarrierKind(object, state, access.write_barrier_kind);
+      ComputeWriteBarrierKind(object, value, state, access.write_barrier_kind);
   Node* offset = jsgraph()->IntPtrConstant(access.offset - access.tag());
   node->InsertInput(graph()->zone(), 1, offset);
   NodeProperties::ChangeOp(
@@ -419,10 +421,19 @@ Node* MemoryOptimizer::ComputeIndex(ElementAccess const& access, Node* key) {
 }
 
 WriteBarrierKind MemoryOptimizer::ComputeWriteBarrierKind(
-    Node* object, AllocationState const* state,
+    Node* object, Node* value, AllocationState const* state,
     WriteBarrierKind write_barrier_kind) {
-  if (state->IsNewSpaceAllocation() && state->group()->Contains(object)) {
-    write_barrier_kind = kNoWriteBarrier;
+  if (state->group() && state->group()->Contains(object)) {
+    if (state->IsNewSpaceAllocation()) {
+      write_barrier_kind = kNoWriteBarrier;
+    } else if (state->group()->Contains(value)) {
+      // Both objects are part of the same pretenured allocation group, i.e.
+      // they were bump allocated from the same old space linear allocation
+      // area without an intervening call. The store neither creates an
+      // old-to-new reference nor can it hide a white object behind a black
+      // one, as black allocation colors the whole area uniformly.
+      write_barrier_kind = kNoWriteBarrier;
+    }
   }
   return write_barrier_kind;
 }
@@ -116,7 +116,7 @@ class MemoryOptimizer final {
   void VisitOtherEffect(Node*, AllocationState const*);
 
   Node* ComputeIndex(ElementAccess const&, Node*);
-  WriteBarrierKind ComputeWriteBarrierKind(Node* object,
+  WriteBarrierKind ComputeWriteBarrierKind(Node* object, Node* value,
                                            AllocationState const* state,
                                            WriteBarrierKind);
 
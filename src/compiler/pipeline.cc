@@ -36,6 +36,7 @@
 #include "src/compiler/js-context-specialization.h"
 #include "src/compiler/js-create-lowering.h"
 #include "src/compiler/js-generic-lowering.h"
+#include "src/compiler/js-heap-broker.h"
 #include "src/compiler/js-inlining-heuristic.h"
 #include "src/compiler/js-intrinsic-lowering.h"
 #include "src/compiler/js-native-context-specialization.h"
@@ -110,6 +111,11 @@ class PipelineData {
     javascript_ = new (graph_zone_) JSOperatorBuilder(graph_zone_);
     jsgraph_ = new (graph_zone_)
         JSGraph(isolate_, graph_, common_, javascript_, simplified_, machine_);
+    if (FLAG_concurrent_typed_lowering) {
+      // The broker outlives the graph zone, it commits the code dependencies
+      // of the background phases when the job is finalized.
+      broker_ = new (info_->zone()) JSHeapBroker(isolate_, info_->zone());
+    }
   }
 
   // For WebAssembly compile entry point.
@@ -213,6 +219,9 @@ class PipelineData {
   CommonOperatorBuilder* common() const { return common_; }
   JSOperatorBuilder* javascript() const { return javascript_; }
   JSGraph* jsgraph() const { return jsgraph_; }
+  JSHeapBroker* broker() const { return broker_; }
+  Typer::Flags typer_flags() const { return typer_flags_; }
+  void set_typer_flags(Typer::Flags flags) { typer_flags_ = flags; }
   Handle<Context> native_context() const {
     return handle(info()->native_context(), isolate());
   }
@@ -318,11 +327,12 @@ class PipelineData {
   }
 
   void InitializeRegisterAllocationData(const RegisterConfiguration* config,
-                                        CallDescriptor* descriptor) {
+                                        CallDescriptor* descriptor,
+                                        RegisterAllocationMode mode) {
     DCHECK(register_allocation_data_ == nullptr);
     register_allocation_data_ = new (register_allocation_zone())
         RegisterAllocationData(config, register_allocation_zone(), frame(),
-                               sequence(), debug_name());
+                               sequence(), debug_name(), mode);
   }
 
   void InitializeOsrHelper() {
@@ -369,6 +379,8 @@ class PipelineData {
   base::Optional<OsrHelper> osr_helper_;
   Handle<Code> code_ = Handle<Code>::null();
   CodeGenerator* code_generator_ = nullptr;
+  JSHeapBroker* broker_ = nullptr;
+  Typer::Flags typer_flags_ = Typer::kNoFlags;
 
   // All objects in the following group of fields are allocated in graph_zone_.
   // They are all set to nullptr when the graph_zone_ is destroyed.
@@ -433,6 +445,9 @@ class PipelineImpl final {
   // Run the graph creation and initial optimization passes.
   bool CreateGraph();
 
+  // Run the typer and the type-sensitive lowerings and optimizations.
+  void TypeAndLowerGraph(Typer::Flags flags);
+
   // Run the concurrent optimization passes.
   bool OptimizeGraph(Linkage* linkage);
 
@@ -676,6 +691,11 @@ PipelineCompilationJob::Status PipelineCompilationJob::FinalizeJobImpl() {
     }
     return FAILED;
   }
+  JSHeapBroker* broker = data_.broker();
+  if (broker != nullptr &&
+      !broker->CommitDependencies(compilation_info()->dependencies())) {
+    return RetryOptimization(kBailedOutDueToDependencyChange);
+  }
   compilation_info()->dependencies()->Commit(code);
   compilation_info()->SetCode(code);
 
@@ -1024,24 +1044,32 @@ struct TypedLoweringPhase {
     JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
     DeadCodeElimination dead_code_elimination(&graph_reducer, data->graph(),
                                               data->common());
-    JSBuiltinReducer builtin_reducer(
-        &graph_reducer, data->jsgraph(),
-        data->info()->dependencies(), data->native_context());
-    Handle<FeedbackVector> feedback_vector(
-        data->info()->closure()->feedback_vector());
-    JSCreateLowering create_lowering(
-        &graph_reducer, data->info()->dependencies(), data->jsgraph(),
-        feedback_vector, data->native_context(), temp_zone);
-    JSTypedLowering typed_lowering(&graph_reducer, data->jsgraph(), temp_zone);
+    // The builtin reducer and the create lowering allocate handles in many
+    // places and are not run off the main thread yet.
+    base::Optional<JSBuiltinReducer> builtin_reducer;
+    base::Optional<JSCreateLowering> create_lowering;
+    if (data->broker() == nullptr) {
+      builtin_reducer.emplace(&graph_reducer, data->jsgraph(),
+                              data->info()->dependencies(),
+                              data->native_context());
+      Handle<FeedbackVector> feedback_vector(
+          data->info()->closure()->feedback_vector());
+      create_lowering.emplace(&graph_reducer, data->info()->dependencies(),
+                              data->jsgraph(), feedback_vector,
+                              data->native_context(), temp_zone);
+    }
+    JSTypedLowering typed_lowering(&graph_reducer, data->jsgraph(),
+                                   data->broker(), temp_zone);
     TypedOptimization typed_optimization(
-        &graph_reducer, data->info()->dependencies(), data->jsgraph());
+        &graph_reducer, data->info()->dependencies(), data->jsgraph(),
+        data->broker());
     SimplifiedOperatorReducer simple_reducer(&graph_reducer, data->jsgraph());
     CheckpointElimination checkpoint_elimination(&graph_reducer);
     CommonOperatorReducer common_reducer(&graph_reducer, data->graph(),
                                          data->common(), data->machine());
     AddReducer(data, &graph_reducer, &dead_code_elimination);
-    AddReducer(data, &graph_reducer, &builtin_reducer);
-    AddReducer(data, &graph_reducer, &create_lowering);
+    if (builtin_reducer) AddReducer(data, &graph_reducer, &*builtin_reducer);
+    if (create_lowering) AddReducer(data, &graph_reducer, &*create_lowering);
     AddReducer(data, &graph_reducer, &typed_optimization);
     AddReducer(data, &graph_reducer, &typed_lowering);
     AddReducer(data, &graph_reducer, &simple_reducer);
@@ -1052,6 +1080,14 @@ struct TypedLoweringPhase {
 };
 
 
+struct HeapBrokerSerializationPhase {
+  static const char* phase_name() { return "serialize heap data"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    data->broker()->SerializeGraph(data->jsgraph(), temp_zone);
+  }
+};
+
 struct EscapeAnalysisPhase {
   static const char* phase_name() { return "escape analysis"; }
 
@@ -1629,30 +1665,25 @@ bool PipelineImpl::CreateGraph() {
   Run<EarlyGraphTrimmingPhase>();
   RunPrintAndVerify("Early trimmed", true);
 
-  // Run the type-sensitive lowerings and optimizations on the graph.
-  {
-    // Determine the Typer operation flags.
-    Typer::Flags flags = Typer::kNoFlags;
-    if (is_sloppy(info()->shared_info()->language_mode()) &&
-        info()->shared_info()->IsUserJavaScript()) {
-      // Sloppy mode functions always have an Object for this.
-      flags |= Typer::kThisIsReceiver;
-    }
-    if (IsClassConstructor(info()->shared_info()->kind())) {
-      // Class constructors cannot be [[Call]]ed.
-      flags |= Typer::kNewTargetIsReceiver;
-    }
-
-    // Type the graph and keep the Typer running on newly created nodes within
-    // this scope; the Typer is automatically unlinked from the Graph once we
-    // leave this scope below.
-    Typer typer(isolate(), flags, data->graph());
-    Run<TyperPhase>(&typer);
-    RunPrintAndVerify("Typed");
+  // Determine the Typer operation flags.
+  Typer::Flags flags = Typer::kNoFlags;
+  if (is_sloppy(info()->shared_info()->language_mode()) &&
+      info()->shared_info()->IsUserJavaScript()) {
+    // Sloppy mode functions always have an Object for this.
+    flags |= Typer::kThisIsReceiver;
+  }
+  if (IsClassConstructor(info()->shared_info()->kind())) {
+    // Class constructors cannot be [[Call]]ed.
+    flags |= Typer::kNewTargetIsReceiver;
+  }
 
-    // Lower JSOperators where we can determine types.
-    Run<TypedLoweringPhase>();
-    RunPrintAndVerify("Lowered typed");
+  if (data->broker() == nullptr) {
+    TypeAndLowerGraph(flags);
+  } else {
+    // Typing and typed lowering happen on the background thread as part of
+    // OptimizeGraph, snapshot the heap data they need.
+    data->set_typer_flags(flags);
+    Run<HeapBrokerSerializationPhase>();
   }
 
   // Do some hacky things to prepare for the optimization phase.
@@ -1664,11 +1695,29 @@ bool PipelineImpl::CreateGraph() {
   return true;
 }
 
+void PipelineImpl::TypeAndLowerGraph(Typer::Flags flags) {
+  // Type the graph and keep the Typer running on newly created nodes until
+  // the typed lowering is done; the Typer is automatically unlinked from the
+  // Graph once we return.
+  Typer typer(isolate(), flags, data_->graph(), data_->broker());
+  Run<TyperPhase>(&typer);
+  RunPrintAndVerify("Typed");
+
+  // Lower JSOperators where we can determine types.
+  Run<TypedLoweringPhase>();
+  RunPrintAndVerify("Lowered typed");
+}
+
 bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   PipelineData* data = this->data_;
 
   data->BeginPhaseKind("lowering");
 
+  if (data->broker() != nullptr) {
+    // The heap data these phases need was snapshotted by the broker.
+    TypeAndLowerGraph(data->typer_flags());
+  }
+
   if (data->info()->is_loop_peeling_enabled()) {
     Run<LoopPeelingPhase>();
     RunPrintAndVerify("Loops peeled", true);
@@ -2081,7 +2130,17 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   data_->sequence()->ValidateDeferredBlockExitPaths();
 #endif
 
-  data->InitializeRegisterAllocationData(config, descriptor);
+  // Very large functions are allocated in the fast mode, which trades code
+  // quality for compile time.
+  int threshold = FLAG_turbo_fast_register_allocation_threshold;
+  size_t instruction_count = data->sequence()->instructions().size();
+  bool fast_mode =
+      (info()->IsWasm() && FLAG_wasm_fast_register_allocation) ||
+      (threshold > 0 && instruction_count > static_cast<size_t>(threshold));
+  RegisterAllocationMode mode = fast_mode ? RegisterAllocationMode::kFast
+                                          : RegisterAllocationMode::kDefault;
+
+  data->InitializeRegisterAllocationData(config, descriptor, mode);
   if (info()->is_osr()) data->osr_helper()->SetupFrame(data->frame());
 
   Run<MeetRegisterConstraintsPhase>();
@@ -2100,14 +2159,14 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
               ->RangesDefinedInDeferredStayInDeferred());
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (FLAG_turbo_preprocess_ranges && !fast_mode) {
     Run<SplinterLiveRangesPhase>();
   }
 
   Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
   Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (FLAG_turbo_preprocess_ranges && !fast_mode) {
     Run<MergeSplintersPhase>();
   }
 
@@ -2125,7 +2184,7 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   Run<PopulateReferenceMapsPhase>();
   Run<ConnectRangesPhase>();
   Run<ResolveControlFlowPhase>();
-  if (FLAG_turbo_move_optimization) {
+  if (FLAG_turbo_move_optimization && !fast_mode) {
     Run<OptimizeMovesPhase>();
   }
 
@@ -1351,12 +1351,14 @@ void RegisterAllocationData::PhiMapValue::CommitAssignment(
 
 RegisterAllocationData::RegisterAllocationData(
     const RegisterConfiguration* config, Zone* zone, Frame* frame,
-    InstructionSequence* code, const char* debug_name)
+    InstructionSequence* code, const char* debug_name,
+    RegisterAllocationMode mode)
     : allocation_zone_(zone),
       frame_(frame),
       code_(code),
       debug_name_(debug_name),
       config_(config),
+      mode_(mode),
       phi_map_(allocation_zone()),
       live_in_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
       live_out_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
@@ -2793,8 +2795,10 @@ void LinearScanAllocator::AllocateRegisters() {
     TRACE("Processing interval %d:%d start=%d\n", current->TopLevel()->vreg(),
           current->relative_id(), position.value());
 
-    if (current->IsTopLevel() && TryReuseSpillForPhi(current->TopLevel()))
+    if (current->IsTopLevel() && !data()->is_fast_mode() &&
+        TryReuseSpillForPhi(current->TopLevel())) {
       continue;
+    }
 
     for (size_t i = 0; i < active_live_ranges().size(); ++i) {
       LiveRange* cur_active = active_live_ranges()[i];
@@ -3532,8 +3536,10 @@ OperandAssigner::OperandAssigner(RegisterAllocationData* data) : data_(data) {}
 
 void OperandAssigner::AssignSpillSlots() {
   ZoneVector<SpillRange*>& spill_ranges = data()->spill_ranges();
-  // Merge disjoint spill ranges
-  for (size_t i = 0; i < spill_ranges.size(); ++i) {
+  // Merge disjoint spill ranges. Every spill range gets a slot of its own in
+  // the fast mode.
+  size_t merge_count = data()->is_fast_mode() ? 0 : spill_ranges.size();
+  for (size_t i = 0; i < merge_count; ++i) {
     SpillRange* range = spill_ranges[i];
     if (range == nullptr) continue;
     if (range->IsEmpty()) continue;
@@ -19,6 +19,13 @@ namespace compiler {
 
 enum RegisterKind { GENERAL_REGISTERS, FP_REGISTERS };
 
+// The fast mode is used for very large functions, where compile time matters
+// more than the quality of the generated code. It leaves out the heuristics
+// that only improve the code: the splintering of ranges in deferred code, the
+// reuse of spill slots for phis, the merging of spill ranges (which is
+// quadratic in the number of spilled values) and the move optimization.
+enum class RegisterAllocationMode { kDefault, kFast };
+
 // This class represents a single point of a InstructionOperand's lifetime. For
 // each instruction there are four lifetime positions:
 //
@@ -767,7 +774,9 @@ class RegisterAllocationData final : public ZoneObject {
   RegisterAllocationData(const RegisterConfiguration* config,
                          Zone* allocation_zone, Frame* frame,
                          InstructionSequence* code,
-                         const char* debug_name = nullptr);
+                         const char* debug_name = nullptr,
+                         RegisterAllocationMode mode =
+                             RegisterAllocationMode::kDefault);
 
   const ZoneVector<TopLevelLiveRange*>& live_ranges() const {
     return live_ranges_;
@@ -811,6 +820,7 @@ class RegisterAllocationData final : public ZoneObject {
   Frame* frame() const { return frame_; }
   const char* debug_name() const { return debug_name_; }
   const RegisterConfiguration* config() const { return config_; }
+  bool is_fast_mode() const { return mode_ == RegisterAllocationMode::kFast; }
 
   MachineRepresentation RepresentationFor(int virtual_register);
 
@@ -853,6 +863,7 @@ class RegisterAllocationData final : public ZoneObject {
   InstructionSequence* const code_;
   const char* const debug_name_;
   const RegisterConfiguration* const config_;
+  const RegisterAllocationMode mode_;
   PhiMap phi_map_;
   ZoneVector<BitVector*> live_in_sets_;
   ZoneVector<BitVector*> live_out_sets_;
@@ -6,6 +6,7 @@
 
 #include "src/compilation-dependencies.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/js-heap-broker.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
 #include "src/compiler/type-cache.h"
@@ -17,10 +18,11 @@ namespace compiler {
 
 TypedOptimization::TypedOptimization(Editor* editor,
                                      CompilationDependencies* dependencies,
-                                     JSGraph* jsgraph)
+                                     JSGraph* jsgraph, JSHeapBroker* broker)
     : AdvancedReducer(editor),
       dependencies_(dependencies),
       jsgraph_(jsgraph),
+      broker_(broker),
       true_type_(Type::HeapConstant(factory()->true_value(), graph()->zone())),
       false_type_(
           Type::HeapConstant(factory()->false_value(), graph()->zone())),
@@ -109,17 +111,26 @@ Reduction TypedOptimization::Reduce(Node* node) {
   return NoChange();
 }
 
-namespace {
-
-MaybeHandle<Map> GetStableMapFromObjectType(Type* object_type) {
+MaybeHandle<Map> TypedOptimization::GetStableMapFromObjectType(
+    Type* object_type) {
   if (object_type->IsHeapConstant()) {
-    Handle<Map> object_map(object_type->AsHeapConstant()->Value()->map());
+    Handle<HeapObject> object = object_type->AsHeapConstant()->Value();
+    if (broker() != nullptr) return broker()->GetStableMap(object);
+    Handle<Map> object_map(object->map());
     if (object_map->is_stable()) return object_map;
   }
   return MaybeHandle<Map>();
 }
 
-}  // namespace
+void TypedOptimization::AssumeMapStable(Handle<Map> map) {
+  // Maps that cannot transition are skipped when the dependencies are
+  // installed, so there is no need to look at {map} here.
+  if (broker() != nullptr) {
+    broker()->AssumeMapStable(map);
+  } else {
+    dependencies()->AssumeMapStable(map);
+  }
+}
 
 Reduction TypedOptimization::ReduceCheckHeapObject(Node* node) {
   Node* const input = NodeProperties::GetValueInput(node, 0);
@@ -157,9 +168,7 @@ Reduction TypedOptimization::ReduceCheckMaps(Node* node) {
       Type* const map_type = NodeProperties::GetType(map);
       if (map_type->IsHeapConstant() &&
           map_type->AsHeapConstant()->Value().is_identical_to(object_map)) {
-        if (object_map->CanTransition()) {
-          dependencies()->AssumeMapStable(object_map);
-        }
+        AssumeMapStable(object_map);
         return Replace(effect);
       }
     }
@@ -210,9 +219,7 @@ Reduction TypedOptimization::ReduceLoadField(Node* node) {
     //      stability of map (to guard the Constant type information).
     Handle<Map> object_map;
     if (GetStableMapFromObjectType(object_type).ToHandle(&object_map)) {
-      if (object_map->CanTransition()) {
-        dependencies()->AssumeMapStable(object_map);
-      }
+      AssumeMapStable(object_map);
       Node* const value = jsgraph()->HeapConstant(object_map);
       ReplaceWithValue(node, value);
       return Replace(value);
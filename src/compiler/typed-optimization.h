@@ -21,14 +21,17 @@ namespace compiler {
 
 // Forward declarations.
 class JSGraph;
+class JSHeapBroker;
 class SimplifiedOperatorBuilder;
 class TypeCache;
 
 class V8_EXPORT_PRIVATE TypedOptimization final
     : public NON_EXPORTED_BASE(AdvancedReducer) {
  public:
+  // With a {broker} the map stability assumptions are recorded on the broker
+  // instead of {dependencies}, which can only be changed on the main thread.
   TypedOptimization(Editor* editor, CompilationDependencies* dependencies,
-                    JSGraph* jsgraph);
+                    JSGraph* jsgraph, JSHeapBroker* broker);
   ~TypedOptimization();
 
   const char* reducer_name() const override { return "TypedOptimization"; }
@@ -51,15 +54,20 @@ class V8_EXPORT_PRIVATE TypedOptimization final
   Reduction ReduceSpeculativeToNumber(Node* node);
   Reduction ReduceCheckNotTaggedHole(Node* node);
 
+  MaybeHandle<Map> GetStableMapFromObjectType(Type* object_type);
+  void AssumeMapStable(Handle<Map> map);
+
   CompilationDependencies* dependencies() const { return dependencies_; }
   Factory* factory() const;
   Graph* graph() const;
   Isolate* isolate() const;
   JSGraph* jsgraph() const { return jsgraph_; }
+  JSHeapBroker* broker() const { return broker_; }
   SimplifiedOperatorBuilder* simplified() const;
 
   CompilationDependencies* const dependencies_;
   JSGraph* const jsgraph_;
+  JSHeapBroker* const broker_;
   Type* const true_type_;
   Type* const false_type_;
   TypeCache const& type_cache_;
@@ -10,6 +10,7 @@
 #include "src/bootstrapper.h"
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
+#include "src/compiler/js-heap-broker.h"
 #include "src/compiler/js-operator.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/loop-variable-optimizer.h"
@@ -33,10 +34,12 @@ class Typer::Decorator final : public GraphDecorator {
   Typer* const typer_;
 };
 
-Typer::Typer(Isolate* isolate, Flags flags, Graph* graph)
+Typer::Typer(Isolate* isolate, Flags flags, Graph* graph,
+             JSHeapBroker* broker)
     : isolate_(isolate),
       flags_(flags),
       graph_(graph),
+      broker_(broker),
       decorator_(nullptr),
       cache_(TypeCache::Get()),
       operation_typer_(isolate, zone()) {
@@ -1356,11 +1359,16 @@ Type* Typer::Visitor::TypeJSConstructWithSpread(Node* node) {
 }
 
 Type* Typer::Visitor::JSCallTyper(Type* fun, Typer* t) {
-  if (fun->IsHeapConstant() && fun->AsHeapConstant()->Value()->IsJSFunction()) {
-    Handle<JSFunction> function =
-        Handle<JSFunction>::cast(fun->AsHeapConstant()->Value());
-    if (function->shared()->HasBuiltinFunctionId()) {
-      switch (function->shared()->builtin_function_id()) {
+  if (fun->IsHeapConstant()) {
+    Handle<HeapObject> value = fun->AsHeapConstant()->Value();
+    JSHeapBroker::FunctionData function;
+    bool const is_known_function =
+        t->broker() != nullptr
+            ? t->broker()->GetFunctionData(value, &function)
+            : JSHeapBroker::ReadFunctionData(value, &function);
+    if (is_known_function &&
+        function.builtin_function_id != kInvalidBuiltinFunctionId) {
+      switch (function.builtin_function_id) {
         case kMathRandom:
           return Type::PlainNumber();
         case kMathFloor:
@@ -2025,6 +2033,9 @@ Type* Typer::Visitor::TypeRuntimeAbort(Node* node) { UNREACHABLE(); }
 // Heap constants.
 
 Type* Typer::Visitor::TypeConstant(Handle<Object> value) {
+  // The type of a constant only depends on its instance type and immutable
+  // map bits, which are safe to read off the main thread.
+  AllowHandleDereference allow_deref;
   if (Type::IsInteger(*value)) {
     return Type::Range(value->Number(), value->Number(), zone());
   }
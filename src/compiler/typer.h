@@ -14,6 +14,7 @@ namespace internal {
 namespace compiler {
 
 // Forward declarations.
+class JSHeapBroker;
 class LoopVariableOptimizer;
 
 class V8_EXPORT_PRIVATE Typer {
@@ -25,7 +26,10 @@ class V8_EXPORT_PRIVATE Typer {
   };
   typedef base::Flags<Flag> Flags;
 
-  Typer(Isolate* isolate, Flags flags, Graph* graph);
+  // With a {broker} the typer runs off the main thread and looks up the
+  // function constants it types calls to in the broker.
+  Typer(Isolate* isolate, Flags flags, Graph* graph,
+        JSHeapBroker* broker = nullptr);
   ~Typer();
 
   void Run();
@@ -41,11 +45,13 @@ class V8_EXPORT_PRIVATE Typer {
   Graph* graph() const { return graph_; }
   Zone* zone() const { return graph()->zone(); }
   Isolate* isolate() const { return isolate_; }
+  JSHeapBroker* broker() const { return broker_; }
   OperationTyper* operation_typer() { return &operation_typer_; }
 
   Isolate* const isolate_;
   Flags const flags_;
   Graph* const graph_;
+  JSHeapBroker* const broker_;
   Decorator* decorator_;
   TypeCache const& cache_;
   OperationTyper operation_typer_;
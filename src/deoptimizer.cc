@@ -363,6 +363,7 @@ void Deoptimizer::DeoptimizeFunction(JSFunction* function, Code* code) {
       function->feedback_vector()->increment_deopt_count();
       code->set_deopt_already_counted(true);
     }
+    function->shared()->set_was_optimized(false);
     DeoptimizeMarkedCodeForContext(function->context()->native_context());
   }
 }
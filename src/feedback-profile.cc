@@ -0,0 +1,187 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/feedback-profile.h"
+
+#include <map>
+
+#include "src/base/functional.h"
+#include "src/feedback-vector-inl.h"
+#include "src/heap/heap.h"
+#include "src/objects-inl.h"
+#include "src/parsing/preparse-data.h"
+#include "src/version.h"
+
+namespace v8 {
+namespace internal {
+
+// A profile is a sequence of 32-bit words:
+//   header:   magic number, version hash, source hash, number of functions
+//   function: start position, end position, flags, invocation count,
+//             number of slots
+//   slot:     slot index, slot kind, value
+namespace {
+
+const int kHeaderSize = 4;
+const int kFunctionHeaderSize = 5;
+const int kSlotSize = 3;
+
+const uint32_t kWasOptimizedFlag = 1 << 0;
+
+// Returns false for the slots whose feedback cannot be carried over.
+bool GetPortableFeedback(FeedbackVector* vector, FeedbackSlot slot,
+                         FeedbackSlotKind kind, int* value) {
+  switch (kind) {
+    case FeedbackSlotKind::kBinaryOp:
+    case FeedbackSlotKind::kCompareOp:
+    case FeedbackSlotKind::kForIn:
+      *value = Smi::ToInt(vector->Get(slot));
+      return *value != 0;
+    case FeedbackSlotKind::kCall:
+      *value = CallICNexus(vector, slot).ExtractCallCount();
+      return *value != 0;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+// static
+uint32_t FeedbackProfile::SourceHash(Handle<String> source) {
+  source = String::Flatten(source);
+  DisallowHeapAllocation no_gc;
+  String::FlatContent content = source->GetFlatContent();
+  if (content.IsOneByte()) {
+    Vector<const uint8_t> chars = content.ToOneByteVector();
+    return static_cast<uint32_t>(base::hash_range(chars.begin(), chars.end()));
+  }
+  Vector<const uc16> chars = content.ToUC16Vector();
+  return static_cast<uint32_t>(base::hash_range(chars.begin(), chars.end()));
+}
+
+// static
+ScriptData* FeedbackProfile::Serialize(Isolate* isolate, Handle<Script> script,
+                                       Handle<String> source) {
+  std::vector<uint32_t> words = {kMagicNumber, Version::Hash(),
+                                 SourceHash(source), 0};
+
+  HeapIterator iterator(isolate->heap());
+  DisallowHeapAllocation no_gc;
+
+  // Ordered by start position to make the output deterministic.
+  std::map<int, FeedbackVector*> vectors;
+  for (HeapObject* obj = iterator.next(); obj != nullptr;
+       obj = iterator.next()) {
+    if (!obj->IsFeedbackVector()) continue;
+    FeedbackVector* vector = FeedbackVector::cast(obj);
+    SharedFunctionInfo* shared = vector->shared_function_info();
+    if (shared->script() != *script) continue;
+    FeedbackVector*& entry = vectors[shared->start_position()];
+    if (entry == nullptr ||
+        entry->invocation_count() < vector->invocation_count()) {
+      entry = vector;
+    }
+  }
+
+  for (auto& entry : vectors) {
+    FeedbackVector* vector = entry.second;
+    SharedFunctionInfo* shared = vector->shared_function_info();
+    words.push_back(shared->start_position());
+    words.push_back(shared->end_position());
+    words.push_back(shared->was_optimized() ? kWasOptimizedFlag : 0);
+    words.push_back(vector->invocation_count());
+    size_t slot_count_index = words.size();
+    words.push_back(0);
+
+    FeedbackMetadataIterator iter(vector->metadata());
+    while (iter.HasNext()) {
+      FeedbackSlot slot = iter.Next();
+      int value;
+      if (!GetPortableFeedback(vector, slot, iter.kind(), &value)) continue;
+      words.push_back(slot.ToInt());
+      words.push_back(static_cast<uint32_t>(iter.kind()));
+      words.push_back(value);
+      words[slot_count_index]++;
+    }
+  }
+  words[kHeaderSize - 1] = static_cast<uint32_t>(vectors.size());
+
+  int length = static_cast<int>(words.size() * kUInt32Size);
+  byte* data = NewArray<byte>(length);
+  CopyBytes(data, reinterpret_cast<const byte*>(words.data()), length);
+  ScriptData* result = new ScriptData(data, length);
+  result->AcquireDataOwnership();
+  return result;
+}
+
+bool FeedbackProfile::Register(Handle<Script> script, Handle<String> source,
+                               const ScriptData* data) {
+  if (data->length() % kUInt32Size != 0) return false;
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(data->data());
+  size_t size = data->length() / kUInt32Size;
+  if (size < kHeaderSize || words[0] != kMagicNumber ||
+      words[1] != Version::Hash() || words[2] != SourceHash(source)) {
+    return false;
+  }
+
+  ScriptProfile profile;
+  size_t pos = kHeaderSize;
+  for (uint32_t i = 0; i < words[kHeaderSize - 1]; i++) {
+    if (size - pos < kFunctionHeaderSize) return false;
+    int start_position = static_cast<int>(words[pos]);
+    FunctionData& function = profile[start_position];
+    function.end_position = static_cast<int>(words[pos + 1]);
+    function.was_optimized = (words[pos + 2] & kWasOptimizedFlag) != 0;
+    function.invocation_count = static_cast<int>(words[pos + 3]);
+    uint32_t slot_count = words[pos + 4];
+    pos += kFunctionHeaderSize;
+    if ((size - pos) / kSlotSize < slot_count) return false;
+    for (uint32_t j = 0; j < slot_count; j++) {
+      function.slots.push_back({static_cast<int>(words[pos]),
+                                static_cast<int>(words[pos + 1]),
+                                static_cast<int>(words[pos + 2])});
+      pos += kSlotSize;
+    }
+  }
+  if (pos != size) return false;
+
+  scripts_[script->id()] = std::move(profile);
+  return true;
+}
+
+void FeedbackProfile::Apply(FeedbackVector* vector) {
+  if (scripts_.empty()) return;
+  DisallowHeapAllocation no_gc;
+  SharedFunctionInfo* shared = vector->shared_function_info();
+  if (!shared->script()->IsScript()) return;
+  auto script_it = scripts_.find(Script::cast(shared->script())->id());
+  if (script_it == scripts_.end()) return;
+  auto it = script_it->second.find(shared->start_position());
+  if (it == script_it->second.end()) return;
+  const FunctionData& function = it->second;
+  if (function.end_position != shared->end_position()) return;
+
+  vector->set_invocation_count(function.invocation_count);
+  if (function.was_optimized) shared->set_was_optimized(true);
+
+  FeedbackMetadata* metadata = vector->metadata();
+  for (const SlotData& slot_data : function.slots) {
+    if (slot_data.slot < 0 || slot_data.slot >= metadata->slot_count()) {
+      continue;
+    }
+    FeedbackSlot slot(slot_data.slot);
+    FeedbackSlotKind kind = metadata->GetKind(slot);
+    if (static_cast<int>(kind) != slot_data.kind) continue;
+    if (!Smi::IsValid(slot_data.value)) continue;
+    if (kind == FeedbackSlotKind::kCall) {
+      CallICNexus(vector, slot).SetCallCount(slot_data.value);
+    } else {
+      vector->Set(slot, Smi::FromInt(slot_data.value), SKIP_WRITE_BARRIER);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,79 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_FEEDBACK_PROFILE_H_
+#define V8_FEEDBACK_PROFILE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "src/globals.h"
+#include "src/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class FeedbackVector;
+class Script;
+class ScriptData;
+
+// A feedback profile carries the type feedback of a script over to the next
+// process, so that its functions can be optimized for the right types right
+// after start-up. Only the feedback that does not refer to heap objects can be
+// carried over: the binary operation, compare operation and for-in hints, the
+// call counts and the invocation counts. The profile also remembers which
+// functions were optimized, see SharedFunctionInfo::was_optimized.
+//
+// Functions are identified by their source range. A profile is rejected if
+// the source or the V8 version differ, and a slot is only filled if its kind
+// still matches.
+class FeedbackProfile {
+ public:
+  FeedbackProfile() {}
+
+  // Collects the feedback of the functions of {script} that have a feedback
+  // vector. If a function has several closures, the most invoked one wins.
+  static ScriptData* Serialize(Isolate* isolate, Handle<Script> script,
+                               Handle<String> source);
+
+  // Registers the profile in {data} for {script}. It is applied to the
+  // feedback vectors that are created for the functions of the script from
+  // now on. Returns false if the profile does not belong to {source}.
+  bool Register(Handle<Script> script, Handle<String> source,
+                const ScriptData* data);
+
+  // Fills a newly created feedback vector from the profile of its script.
+  void Apply(FeedbackVector* vector);
+
+ private:
+  struct SlotData {
+    int slot;
+    int kind;
+    int value;
+  };
+
+  struct FunctionData {
+    int end_position;
+    int invocation_count;
+    bool was_optimized;
+    std::vector<SlotData> slots;
+  };
+
+  // Functions by start position.
+  typedef std::unordered_map<int, FunctionData> ScriptProfile;
+
+  static const uint32_t kMagicNumber = 0xFEEDBAC4;
+
+  static uint32_t SourceHash(Handle<String> source);
+
+  // Profiles by script id.
+  std::unordered_map<int, ScriptProfile> scripts_;
+
+  DISALLOW_COPY_AND_ASSIGN(FeedbackProfile);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_FEEDBACK_PROFILE_H_
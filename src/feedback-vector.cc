@@ -4,6 +4,7 @@
 
 #include "src/feedback-vector.h"
 #include "src/code-stubs.h"
+#include "src/feedback-profile.h"
 #include "src/feedback-vector-inl.h"
 #include "src/ic/ic-inl.h"
 #include "src/objects.h"
@@ -301,6 +302,7 @@ Handle<FeedbackVector> FeedbackVector::New(Isolate* isolate,
   if (!isolate->is_best_effort_code_coverage()) {
     AddToCodeCoverageList(isolate, result);
   }
+  isolate->feedback_profile()->Apply(*result);
   return result;
 }
 
@@ -367,6 +369,7 @@ void FeedbackVector::EvictOptimizedCodeMarkedForDeoptimization(
       increment_deopt_count();
       code->set_deopt_already_counted(true);
     }
+    shared->set_was_optimized(false);
     ClearOptimizedCode();
   }
 }
@@ -651,6 +654,10 @@ int CallICNexus::ExtractCallCount() {
   return value;
 }
 
+void CallICNexus::SetCallCount(int count) {
+  SetFeedbackExtra(Smi::FromInt(count), SKIP_WRITE_BARRIER);
+}
+
 float CallICNexus::ComputeCallFrequency() {
   double const invocation_count = vector()->invocation_count();
   double const call_count = ExtractCallCount();
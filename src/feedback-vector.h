@@ -633,6 +633,7 @@ class CallICNexus final : public FeedbackNexus {
   }
 
   int ExtractCallCount();
+  void SetCallCount(int count);
 
   // Compute the call frequency based on the call count and the invocation
   // count (taken from the type feedback vector).
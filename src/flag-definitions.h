@@ -359,6 +359,9 @@ DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
+DEFINE_BOOL(concurrent_typed_lowering, false,
+            "run the TurboFan typer and typed lowering on the concurrent "
+            "recompilation thread")
 
 // Flags for stress-testing the compiler.
 DEFINE_INT(stress_runs, 0, "number of stress runs")
@@ -371,6 +374,11 @@ DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
             "run pre-register allocation heuristics")
+DEFINE_INT(turbo_fast_register_allocation_threshold, 50000,
+           "use the fast register allocation mode for functions with more "
+           "instructions than this (0 to disable)")
+DEFINE_BOOL(wasm_fast_register_allocation, false,
+            "use the fast register allocation mode for all wasm functions")
 DEFINE_STRING(turbo_filter, "*", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
 DEFINE_BOOL(trace_turbo_graph, false, "trace generated TurboFan graphs")
@@ -625,13 +633,26 @@ DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
 DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(minor_mc, false, "perform young generation mark compact GCs")
+DEFINE_BOOL(minor_mc_promote_in_place, false,
+            "promote all young generation pages with live objects by moving "
+            "the pages instead of copying the surviving objects")
+DEFINE_IMPLICATION(minor_mc_promote_in_place, minor_mc)
+DEFINE_BOOL(young_generation_large_objects, false,
+            "allocate large objects in the young generation by default, so "
+            "that the scavenger can reclaim them")
+DEFINE_NEG_IMPLICATION(minor_mc, young_generation_large_objects)
 DEFINE_BOOL(black_allocation, true, "use black allocation")
 DEFINE_BOOL(concurrent_store_buffer, true,
             "use concurrent store buffer processing")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(parallel_map_clearing, true,
+            "compact transition arrays and sort descriptor arrays of dead "
+            "maps in parallel")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_global_handles, true,
+            "identify weak global handles in parallel during mark-compact")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -659,13 +680,31 @@ DEFINE_BOOL(verify_heap_skip_remembered_set, false,
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_INT(array_buffer_pool_size, 0,
+           "maximum size (in KBytes) of freed array buffer backing stores kept "
+           "for reuse by new array buffers of the same length (0 disables "
+           "pooling)")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "back the pointer compression cage with transparent huge pages "
+            "where the OS supports it; without the cage, only chunks of at "
+            "least 2MB (large objects) are backed, regular pages are not")
+DEFINE_BOOL(discard_pooled_pages, true,
+            "keep pooled pages mapped and release their memory with madvise "
+            "instead of uncommitting them")
+DEFINE_INT(max_pooled_pages, 64,
+           "maximum number of freed pages the unmapper keeps for reuse "
+           "depending on the allocation rate (0 disables adaptive pooling)")
 DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
+DEFINE_INT(compaction_time_budget, 0,
+           "upper bound in ms for evacuating pages during a single full GC; "
+           "pages exceeding the budget are left for subsequent GCs (0 means "
+           "no explicit budget)")
 DEFINE_BOOL(cleanup_code_caches_at_gc, true,
             "Flush code caches in maps during mark compact cycle.")
 DEFINE_BOOL(use_marking_progress_bar, true,
@@ -727,6 +766,9 @@ DEFINE_BOOL(enable_regexp_unaligned_accesses, true,
 
 // api.cc
 DEFINE_BOOL(script_streaming, true, "enable parsing on background")
+DEFINE_BOOL(concurrent_string_table_lookup, false,
+            "look up parsed strings in the string table on the background "
+            "parsing thread")
 DEFINE_BOOL(disable_old_api_accessors, false,
             "Disable old-style API accessors whose setters trigger through the "
             "prototype chain")
@@ -771,6 +813,10 @@ DEFINE_BOOL(opt, true, "use adaptive optimizations")
 DEFINE_BOOL(always_opt, false, "always try to optimize functions")
 DEFINE_BOOL(always_osr, false, "always try to OSR functions")
 DEFINE_BOOL(prepare_always_opt, false, "prepare for turning on always opt")
+DEFINE_BOOL(reoptimize_previously_optimized, true,
+            "optimize functions that were optimized before, possibly in the "
+            "process that created their code cache, after a single profiler "
+            "tick")
 
 DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
@@ -866,6 +912,14 @@ DEFINE_BOOL(native_code_counters, false,
 
 // objects.cc
 DEFINE_BOOL(thin_strings, true, "Enable ThinString support")
+DEFINE_BOOL(string_deduplication, false,
+            "deduplicate equal sequential strings in old space after full "
+            "mark-compact GCs")
+DEFINE_INT(string_deduplication_min_length, 16,
+           "minimum length of strings considered for deduplication")
+DEFINE_INT(string_deduplication_max_candidates, 10000,
+           "maximum number of strings considered for deduplication per GC")
+DEFINE_IMPLICATION(string_deduplication, thin_strings)
 DEFINE_BOOL(trace_weak_arrays, false, "Trace WeakFixedArray usage")
 DEFINE_BOOL(trace_prototype_users, false,
             "Trace updates to prototype user tracking")
@@ -1232,7 +1286,9 @@ DEFINE_NEG_IMPLICATION(single_threaded, concurrent_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(single_threaded, minor_mc_parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compaction)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_map_clearing)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_pointer_update)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_global_handles)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_store_buffer)
 DEFINE_NEG_IMPLICATION(single_threaded, compiler_dispatcher)
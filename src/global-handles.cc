@@ -6,6 +6,7 @@
 
 #include "src/api.h"
 #include "src/cancelable-task.h"
+#include "src/heap/item-parallel-job.h"
 #include "src/objects-inl.h"
 #include "src/v8.h"
 #include "src/visitors.h"
@@ -163,7 +164,13 @@ class GlobalHandles::Node {
   bool IsPendingPhantomCallback() const {
     return state() == PENDING &&
            (weakness_type() == PHANTOM_WEAK ||
-            weakness_type() == PHANTOM_WEAK_2_EMBEDDER_FIELDS);
+            weakness_type() == PHANTOM_WEAK_2_EMBEDDER_FIELDS) &&
+           weak_callback_ != nullptr;
+  }
+
+  bool IsPendingBatchedPhantom() const {
+    return state() == PENDING && weakness_type() == PHANTOM_WEAK &&
+           weak_callback_ == nullptr;
   }
 
   bool IsPendingPhantomResetHandle() const {
@@ -244,6 +251,15 @@ class GlobalHandles::Node {
     weak_callback_ = nullptr;
   }
 
+  void MakeWeakBatched(void* parameter) {
+    DCHECK(IsInUse());
+    CHECK_NE(object_, reinterpret_cast<Object*>(kGlobalHandleZapValue));
+    set_state(WEAK);
+    set_weakness_type(PHANTOM_WEAK);
+    set_parameter(parameter);
+    weak_callback_ = nullptr;
+  }
+
   void* ClearWeakness() {
     DCHECK(IsInUse());
     void* p = parameter();
@@ -283,6 +299,17 @@ class GlobalHandles::Node {
     set_state(NEAR_DEATH);
   }
 
+  void CollectBatchedPhantomParameter(
+      std::vector<void*>* pending_batched_parameters) {
+    DCHECK(IsPendingBatchedPhantom());
+    // The node stays allocated until the embedder resets its handle, so that
+    // the handle never refers to a released or reused node.
+    // Zap with something dangerous.
+    *location() = reinterpret_cast<Object*>(0x6057ca11);
+    pending_batched_parameters->push_back(parameter());
+    set_state(NEAR_DEATH);
+  }
+
   void ResetPhantomHandle() {
     DCHECK(weakness_type() == PHANTOM_WEAK_RESET_HANDLE);
     DCHECK(state() == PENDING);
@@ -533,7 +560,10 @@ GlobalHandles::GlobalHandles(Isolate* isolate)
       first_used_block_(NULL),
       first_free_(NULL),
       post_gc_processing_count_(0),
-      number_of_phantom_handle_resets_(0) {}
+      number_of_phantom_handle_resets_(0),
+      batched_weak_callback_(nullptr),
+      batched_weak_callback_data_(nullptr),
+      identify_weak_handles_semaphore_(0) {}
 
 GlobalHandles::~GlobalHandles() {
   NodeBlock* block = first_block_;
@@ -589,6 +619,21 @@ void GlobalHandles::MakeWeak(Object*** location_addr) {
   Node::FromLocation(*location_addr)->MakeWeak(location_addr);
 }
 
+void GlobalHandles::MakeWeakBatched(Object** location, void* parameter) {
+  Node* node = Node::FromLocation(location);
+  // Only the callback tells the embedder to reset the handle of a dead
+  // object. Without it, the node would never be released.
+  CHECK_NOT_NULL(node->GetGlobalHandles()->batched_weak_callback_);
+  node->MakeWeakBatched(parameter);
+}
+
+void GlobalHandles::SetBatchedWeakCallback(v8::BatchedWeakCallback callback,
+                                           void* data) {
+  CHECK_NOT_NULL(callback);
+  batched_weak_callback_ = callback;
+  batched_weak_callback_data_ = data;
+}
+
 void* GlobalHandles::ClearWeakness(Object** location) {
   return Node::FromLocation(location)->ClearWeakness();
 }
@@ -621,6 +666,8 @@ void GlobalHandles::IterateWeakRoots(RootVisitor* v) {
       if (node->IsPendingPhantomResetHandle()) {
         node->ResetPhantomHandle();
         ++number_of_phantom_handle_resets_;
+      } else if (node->IsPendingBatchedPhantom()) {
+        node->CollectBatchedPhantomParameter(&pending_batched_parameters_);
       } else if (node->IsPendingPhantomCallback()) {
         node->CollectPhantomCallbackData(isolate(),
                                          &pending_phantom_callbacks_);
@@ -632,16 +679,88 @@ void GlobalHandles::IterateWeakRoots(RootVisitor* v) {
 }
 
 
-void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeak() && f(it.node()->location())) {
-      it.node()->MarkPending();
+class GlobalHandles::IdentifyWeakHandlesItem : public ItemParallelJob::Item {
+ public:
+  explicit IdentifyWeakHandlesItem(NodeBlock* block) : block_(block) {}
+  virtual ~IdentifyWeakHandlesItem() {}
+
+  NodeBlock* block() const { return block_; }
+
+ private:
+  NodeBlock* const block_;
+};
+
+class GlobalHandles::IdentifyWeakHandlesTask : public ItemParallelJob::Task {
+ public:
+  IdentifyWeakHandlesTask(Isolate* isolate, WeakSlotCallback f)
+      : ItemParallelJob::Task(isolate), f_(f) {}
+  virtual ~IdentifyWeakHandlesTask() {}
+
+  void RunInParallel() override {
+    IdentifyWeakHandlesItem* item = nullptr;
+    while ((item = GetItem<IdentifyWeakHandlesItem>()) != nullptr) {
+      IdentifyWeakHandles(item->block(), f_);
+      item->MarkFinished();
+    }
+  }
+
+ private:
+  WeakSlotCallback f_;
+};
+
+int GlobalHandles::NumberOfIdentifyWeakHandlesTasks(size_t blocks) {
+  // Identifying a block of weak handles is cheap, so a task only pays off
+  // for tens of thousands of handles.
+  const size_t kBlocksPerTask = 64;
+  const int kMaxTasks = 4;
+  if (!FLAG_parallel_global_handles) return 1;
+  const int tasks = static_cast<int>(blocks / kBlocksPerTask);
+  // The main thread contributes as well.
+  const int threads = static_cast<int>(
+      V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads() + 1);
+  return Max(1, Min(tasks, Min(kMaxTasks, threads)));
+}
+
+void GlobalHandles::IdentifyWeakHandles(NodeBlock* block, WeakSlotCallback f) {
+  for (int i = 0; i < NodeBlock::kSize; i++) {
+    Node* node = block->node_at(i);
+    if (node->IsWeak() && f(node->location())) {
+      node->MarkPending();
     }
   }
 }
 
+void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
+  std::vector<NodeBlock*> blocks;
+  for (NodeBlock* block = first_used_block_; block != nullptr;
+       block = block->next_used()) {
+    blocks.push_back(block);
+  }
+  const int num_tasks = NumberOfIdentifyWeakHandlesTasks(blocks.size());
+  if (num_tasks == 1) {
+    for (NodeBlock* block : blocks) IdentifyWeakHandles(block, f);
+    return;
+  }
+  ItemParallelJob job(isolate_->cancelable_task_manager(),
+                      &identify_weak_handles_semaphore_);
+  for (NodeBlock* block : blocks) {
+    job.AddItem(new IdentifyWeakHandlesItem(block));
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    job.AddTask(new IdentifyWeakHandlesTask(isolate_, f));
+  }
+  job.Run();
+}
+
 void GlobalHandles::IterateNewSpaceStrongAndDependentRoots(RootVisitor* v) {
-  for (Node* node : new_space_nodes_) {
+  IterateNewSpaceStrongAndDependentRoots(v, 0, new_space_nodes_.size());
+}
+
+void GlobalHandles::IterateNewSpaceStrongAndDependentRoots(RootVisitor* v,
+                                                           size_t start,
+                                                           size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    Node* node = new_space_nodes_[i];
     if (node->IsStrongRetainer() ||
         (node->IsWeakRetainer() && !node->is_independent() &&
          node->is_active())) {
@@ -695,6 +814,8 @@ void GlobalHandles::IterateNewSpaceWeakUnmodifiedRoots(RootVisitor* v) {
       if (node->IsPendingPhantomResetHandle()) {
         node->ResetPhantomHandle();
         ++number_of_phantom_handle_resets_;
+      } else if (node->IsPendingBatchedPhantom()) {
+        node->CollectBatchedPhantomParameter(&pending_batched_parameters_);
       } else if (node->IsPendingPhantomCallback()) {
         node->CollectPhantomCallbackData(isolate(),
                                          &pending_phantom_callbacks_);
@@ -834,6 +955,22 @@ int GlobalHandles::DispatchPendingPhantomCallbacks(
 }
 
 
+int GlobalHandles::DispatchBatchedWeakCallback() {
+  if (pending_batched_parameters_.empty()) return 0;
+  // The callback may trigger another garbage collection, which appends to
+  // the pending parameters.
+  std::vector<void*> parameters;
+  parameters.swap(pending_batched_parameters_);
+  DCHECK_NOT_NULL(batched_weak_callback_);
+  {
+    VMState<EXTERNAL> vmstate(isolate());
+    batched_weak_callback_(reinterpret_cast<v8::Isolate*>(isolate()),
+                           parameters.data(), parameters.size(),
+                           batched_weak_callback_data_);
+  }
+  return static_cast<int>(parameters.size());
+}
+
 void GlobalHandles::PendingPhantomCallback::Invoke(Isolate* isolate) {
   Data::Callback* callback_addr = nullptr;
   if (node_ != nullptr) {
@@ -866,6 +1003,12 @@ int GlobalHandles::PostGarbageCollectionProcessing(
       (gc_callback_flags &
        (kGCCallbackFlagForced | kGCCallbackFlagCollectAllAvailableGarbage |
         kGCCallbackFlagSynchronousPhantomCallbackProcessing)) != 0;
+  freed_nodes += DispatchBatchedWeakCallback();
+  if (initial_post_gc_processing_count != post_gc_processing_count_) {
+    // If the callback caused a nested GC, then return.  See comment in
+    // PostScavengeProcessing.
+    return freed_nodes;
+  }
   freed_nodes += DispatchPendingPhantomCallbacks(synchronous_second_pass);
   if (initial_post_gc_processing_count != post_gc_processing_count_) {
     // If the callbacks caused a nested GC, then return.  See comment in
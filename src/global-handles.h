@@ -11,6 +11,7 @@
 #include "include/v8.h"
 #include "include/v8-profiler.h"
 
+#include "src/base/platform/semaphore.h"
 #include "src/handles.h"
 #include "src/utils.h"
 
@@ -34,6 +35,9 @@ enum WeaknessType {
   // fields must contain aligned non-V8 pointers.  Getting pointers to V8
   // objects through this interface would be GC unsafe so in that case the
   // embedder gets a null pointer instead.
+  // Handles made weak with MakeWeakBatched are PHANTOM_WEAK handles without
+  // a callback. When their object dies, their parameters are passed to the
+  // batched weak callback, which must be set, and the embedder resets them.
   PHANTOM_WEAK,
   PHANTOM_WEAK_2_EMBEDDER_FIELDS,
   // The handle is automatically reset by the garbage collector when
@@ -77,6 +81,10 @@ class GlobalHandles {
 
   static void MakeWeak(Object*** location_addr);
 
+  static void MakeWeakBatched(Object** location, void* parameter);
+
+  void SetBatchedWeakCallback(v8::BatchedWeakCallback callback, void* data);
+
   void RecordStats(HeapStats* stats);
 
   // Returns the current number of handles to global objects.
@@ -137,7 +145,8 @@ class GlobalHandles {
   void IterateWeakRoots(RootVisitor* v);
 
   // Find all weak handles satisfying the callback predicate, mark
-  // them as pending.
+  // them as pending. Node blocks are processed by parallel tasks if there
+  // are many of them, so the predicate must be safe to call concurrently.
   void IdentifyWeakHandles(WeakSlotCallback f);
 
   // NOTE: Five ...NewSpace... functions below are used during
@@ -148,6 +157,11 @@ class GlobalHandles {
   // Iterates over strong and dependent handles. See the note above.
   void IterateNewSpaceStrongAndDependentRoots(RootVisitor* v);
 
+  // Iterates over strong and dependent handles in the range [start, end) of
+  // new space nodes. Disjoint ranges may be iterated in parallel.
+  void IterateNewSpaceStrongAndDependentRoots(RootVisitor* v, size_t start,
+                                              size_t end);
+
   // Iterates over strong and dependent handles. See the note above.
   // Also marks unmodified nodes in the same iteration.
   void IterateNewSpaceStrongAndDependentRootsAndIdentifyUnmodified(
@@ -183,6 +197,8 @@ class GlobalHandles {
   class NodeIterator;
   class PendingPhantomCallback;
   class PendingPhantomCallbacksSecondPassTask;
+  class IdentifyWeakHandlesItem;
+  class IdentifyWeakHandlesTask;
 
   explicit GlobalHandles(Isolate* isolate);
 
@@ -192,6 +208,9 @@ class GlobalHandles {
   int PostScavengeProcessing(int initial_post_gc_processing_count);
   int PostMarkSweepProcessing(int initial_post_gc_processing_count);
   int DispatchPendingPhantomCallbacks(bool synchronous_second_pass);
+  int DispatchBatchedWeakCallback();
+  int NumberOfIdentifyWeakHandlesTasks(size_t blocks);
+  static void IdentifyWeakHandles(NodeBlock* block, WeakSlotCallback f);
   void UpdateListOfNewSpaceNodes();
   void ApplyPersistentHandleVisitor(v8::PersistentHandleVisitor* visitor,
                                     Node* node);
@@ -220,6 +239,15 @@ class GlobalHandles {
 
   std::vector<PendingPhantomCallback> pending_phantom_callbacks_;
 
+  v8::BatchedWeakCallback batched_weak_callback_;
+  void* batched_weak_callback_data_;
+
+  // Parameters of the batched handles whose objects died in the last garbage
+  // collection.
+  std::vector<void*> pending_batched_parameters_;
+
+  base::Semaphore identify_weak_handles_semaphore_;
+
   friend class Isolate;
 
   DISALLOW_COPY_AND_ASSIGN(GlobalHandles);
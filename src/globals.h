@@ -214,7 +214,17 @@ const size_t kReservedCodeRangePages = 1;
 const size_t kMinimumCodeRangeSize = 3 * MB;
 const size_t kReservedCodeRangePages = 0;
 #endif
+#ifdef V8_COMPRESS_POINTERS
+// With pointer compression all non-executable heap chunks live in a single
+// 4GB reservation (the cage) whose base is 4GB aligned, so any tagged pointer
+// into the cage is fully described by its lower 32 bits.
+const size_t kPtrComprCageReservationSize = static_cast<size_t>(4) * GB;
+const size_t kPtrComprCageBaseAlignment = static_cast<size_t>(4) * GB;
+#endif
 #else
+#ifdef V8_COMPRESS_POINTERS
+#error "Pointer compression is only supported on 64-bit hosts"
+#endif
 const int kPointerSizeLog2 = 2;
 const intptr_t kIntptrSignBit = 0x80000000;
 const uintptr_t kUintptrAllBitsSet = 0xFFFFFFFFu;
@@ -502,6 +512,7 @@ class MacroAssembler;
 class Map;
 class MapSpace;
 class MarkCompactCollector;
+class NewLargeObjectSpace;
 class NewSpace;
 class Object;
 class OldSpace;
@@ -540,9 +551,10 @@ enum AllocationSpace {
   CODE_SPACE,  // No pointers to new space, marked executable.
   MAP_SPACE,   // Only and all map objects.
   LO_SPACE,    // Promoted large objects.
+  NEW_LO_SPACE,  // Young large objects, collected by the scavenger.
 
   FIRST_SPACE = NEW_SPACE,
-  LAST_SPACE = LO_SPACE,
+  LAST_SPACE = NEW_LO_SPACE,
   FIRST_PAGED_SPACE = OLD_SPACE,
   LAST_PAGED_SPACE = MAP_SPACE
 };
@@ -628,6 +640,7 @@ enum VisitMode {
   VISIT_ALL_IN_MINOR_MC_MARK,
   VISIT_ALL_IN_MINOR_MC_UPDATE,
   VISIT_ALL_IN_SCAVENGE,
+  VISIT_ALL_IN_PARALLEL_SCAVENGE,
   VISIT_ALL_IN_SWEEP_NEWSPACE,
   VISIT_ONLY_STRONG,
   VISIT_ONLY_STRONG_FOR_SERIALIZATION,
@@ -308,6 +308,7 @@
   F(MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS)        \
   F(MC_EVACUATE_UPDATE_POINTERS_WEAK)                \
   F(MC_FINISH)                                       \
+  F(MC_HEAP_STATISTICS)                              \
   F(MC_MARK)                                         \
   F(MC_MARK_FINISH_INCREMENTAL)                      \
   F(MC_MARK_ROOTS)                                   \
@@ -320,6 +321,7 @@
   F(MC_MARK_WRAPPER_PROLOGUE)                        \
   F(MC_MARK_WRAPPER_TRACING)                         \
   F(MC_PROLOGUE)                                     \
+  F(MC_STRING_DEDUPLICATION)                         \
   F(MC_SWEEP)                                        \
   F(MC_SWEEP_CODE)                                   \
   F(MC_SWEEP_MAP)                                    \
@@ -0,0 +1,104 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/array-buffer-pool.h"
+
+#include "src/heap/heap-inl.h"
+#include "src/isolate.h"
+
+namespace v8 {
+namespace internal {
+
+ArrayBufferPool::ArrayBufferPool(Heap* heap)
+    : heap_(heap),
+      max_pooled_bytes_(static_cast<size_t>(FLAG_array_buffer_pool_size) * KB),
+      pooled_bytes_(0) {}
+
+ArrayBufferPool::~ArrayBufferPool() { DCHECK_EQ(0u, pooled_bytes_); }
+
+void* ArrayBufferPool::Allocate(size_t length, bool initialize) {
+  int size_class = SizeClass(length);
+  if (size_class < 0) return nullptr;
+  void* data = nullptr;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    std::vector<void*>& free_list = free_lists_[size_class];
+    if (free_list.empty()) return nullptr;
+    data = free_list.back();
+    free_list.pop_back();
+    pooled_bytes_ -= length;
+  }
+  if (initialize) memset(data, 0, length);
+  return data;
+}
+
+bool ArrayBufferPool::AddLocked(const JSArrayBuffer::Allocation& allocation) {
+  if (allocation.mode != ArrayBuffer::Allocator::AllocationMode::kNormal) {
+    return false;
+  }
+  int size_class = SizeClass(allocation.length);
+  if (size_class < 0) return false;
+  if (pooled_bytes_ + allocation.length > max_pooled_bytes_) return false;
+  free_lists_[size_class].push_back(allocation.allocation_base);
+  pooled_bytes_ += allocation.length;
+  return true;
+}
+
+void ArrayBufferPool::FreeToAllocator(
+    const JSArrayBuffer::Allocation& allocation) {
+  heap_->isolate()->array_buffer_allocator()->Free(
+      allocation.allocation_base, allocation.length, allocation.mode);
+}
+
+void ArrayBufferPool::Free(const JSArrayBuffer::Allocation& allocation) {
+  bool pooled;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    pooled = AddLocked(allocation);
+  }
+  if (!pooled) FreeToAllocator(allocation);
+}
+
+void ArrayBufferPool::Free(
+    const std::vector<JSArrayBuffer::Allocation>& allocations) {
+  std::vector<JSArrayBuffer::Allocation> rejected;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    for (const JSArrayBuffer::Allocation& allocation : allocations) {
+      if (!AddLocked(allocation)) rejected.push_back(allocation);
+    }
+  }
+  for (const JSArrayBuffer::Allocation& allocation : rejected) {
+    FreeToAllocator(allocation);
+  }
+}
+
+void ArrayBufferPool::FreeAll() {
+  std::vector<void*> free_lists[kNumberOfSizeClasses];
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    for (int i = 0; i < kNumberOfSizeClasses; i++) {
+      free_lists[i].swap(free_lists_[i]);
+    }
+    pooled_bytes_ = 0;
+  }
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    const size_t length = (i + 1) * kSizeClassStep;
+    for (void* data : free_lists[i]) {
+      FreeToAllocator(JSArrayBuffer::Allocation(
+          data, length, ArrayBuffer::Allocator::AllocationMode::kNormal));
+    }
+  }
+}
+
+void ArrayBufferPool::TearDown() {
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    max_pooled_bytes_ = 0;
+  }
+  FreeAll();
+}
+
+}  // namespace internal
+}  // namespace v8
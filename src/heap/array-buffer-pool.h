@@ -0,0 +1,87 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_ARRAY_BUFFER_POOL_H_
+#define V8_HEAP_ARRAY_BUFFER_POOL_H_
+
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/globals.h"
+#include "src/objects.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Keeps backing stores of freed array buffers for reuse by new array buffers
+// of the same length. Only lengths that are a multiple of kSizeClassStep up to
+// kMaxPooledLength are pooled, so that a recycled backing store always has
+// exactly the length it was allocated with by the embedder's allocator.
+// Recycled backing stores are zeroed lazily, i.e., only when they are handed
+// out for an array buffer that requires initialized contents.
+//
+// Backing stores are returned to the pool by the sweeper threads, so all
+// operations are thread-safe.
+class ArrayBufferPool {
+ public:
+  static const size_t kSizeClassStep = 4 * KB;
+  static const size_t kMaxPooledLength = 64 * KB;
+
+  explicit ArrayBufferPool(Heap* heap);
+  ~ArrayBufferPool();
+
+  // Returns a recycled backing store of |length| bytes or nullptr if there is
+  // none. The contents are zeroed if |initialize| is true.
+  void* Allocate(size_t length, bool initialize);
+
+  // Keeps the given backing stores for reuse or returns them to the
+  // embedder's allocator if they cannot be pooled.
+  void Free(const JSArrayBuffer::Allocation& allocation);
+  void Free(const std::vector<JSArrayBuffer::Allocation>& allocations);
+
+  // Returns all pooled backing stores to the embedder's allocator.
+  void FreeAll();
+
+  // Returns all pooled backing stores and stops pooling.
+  void TearDown();
+
+  size_t pooled_bytes() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return pooled_bytes_;
+  }
+
+ private:
+  static const int kNumberOfSizeClasses =
+      static_cast<int>(kMaxPooledLength / kSizeClassStep);
+
+  // Returns the size class for |length| or -1 if it is not pooled.
+  static int SizeClass(size_t length) {
+    if (length == 0 || length > kMaxPooledLength ||
+        length % kSizeClassStep != 0) {
+      return -1;
+    }
+    return static_cast<int>(length / kSizeClassStep) - 1;
+  }
+
+  // Adds the allocation to the pool if possible. Must be called with the
+  // mutex held. Returns false if the caller has to free the allocation.
+  bool AddLocked(const JSArrayBuffer::Allocation& allocation);
+
+  void FreeToAllocator(const JSArrayBuffer::Allocation& allocation);
+
+  Heap* heap_;
+  base::Mutex mutex_;
+  size_t max_pooled_bytes_;
+  size_t pooled_bytes_;
+  std::vector<void*> free_lists_[kNumberOfSizeClasses];
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferPool);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_ARRAY_BUFFER_POOL_H_
@@ -6,6 +6,7 @@
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_INL_H_
 
 #include "src/conversions-inl.h"
+#include "src/heap/array-buffer-pool.h"
 #include "src/heap/array-buffer-tracker.h"
 #include "src/heap/heap.h"
 #include "src/objects.h"
@@ -54,13 +55,17 @@ template <typename Callback>
 void LocalArrayBufferTracker::Free(Callback should_free) {
   size_t freed_memory = 0;
   size_t retained_size = 0;
+  // Backing stores of dead buffers are released as a batch after the page has
+  // been processed. Live buffers do not reference them anymore.
+  std::vector<JSArrayBuffer::Allocation> backing_stores_to_free;
   for (TrackingData::iterator it = array_buffers_.begin();
        it != array_buffers_.end();) {
     JSArrayBuffer* buffer = reinterpret_cast<JSArrayBuffer*>(*it);
     const size_t length = buffer->allocation_length();
     if (should_free(buffer)) {
       freed_memory += length;
-      buffer->FreeBackingStore();
+      backing_stores_to_free.emplace_back(buffer->allocation_base(), length,
+                                          buffer->allocation_mode());
       it = array_buffers_.erase(it);
     } else {
       retained_size += length;
@@ -69,6 +74,7 @@ void LocalArrayBufferTracker::Free(Callback should_free) {
   }
   retained_size_ = retained_size;
   if (freed_memory > 0) {
+    heap_->array_buffer_pool()->Free(backing_stores_to_free);
     heap_->update_external_memory_concurrently_freed(
         static_cast<intptr_t>(freed_memory));
   }
@@ -20,6 +20,7 @@ void LocalArrayBufferTracker::Process(Callback callback) {
   JSArrayBuffer* old_buffer = nullptr;
   size_t freed_memory = 0;
   size_t retained_size = 0;
+  std::vector<JSArrayBuffer::Allocation> backing_stores_to_free;
   for (TrackingData::iterator it = array_buffers_.begin();
        it != array_buffers_.end();) {
     old_buffer = reinterpret_cast<JSArrayBuffer*>(*it);
@@ -45,7 +46,8 @@ void LocalArrayBufferTracker::Process(Callback callback) {
       it = array_buffers_.erase(it);
     } else if (result == kRemoveEntry) {
       freed_memory += length;
-      old_buffer->FreeBackingStore();
+      backing_stores_to_free.emplace_back(
+          old_buffer->allocation_base(), length, old_buffer->allocation_mode());
       it = array_buffers_.erase(it);
     } else {
       UNREACHABLE();
@@ -53,6 +55,7 @@ void LocalArrayBufferTracker::Process(Callback callback) {
   }
   retained_size_ = retained_size;
   if (freed_memory > 0) {
+    heap_->array_buffer_pool()->Free(backing_stores_to_free);
     heap_->update_external_memory_concurrently_freed(
         static_cast<intptr_t>(freed_memory));
   }
@@ -244,11 +244,63 @@ class ConcurrentMarkingVisitor final
   }
 
   int VisitJSWeakCollection(Map* map, JSWeakCollection* object) {
-    // TODO(ulan): implement iteration of strong fields.
-    bailout_.Push(object);
+    if (marking_state_.IsGrey(object)) {
+      Object* table = base::AsAtomicPointer::Relaxed_Load(
+          HeapObject::RawField(object, JSWeakCollection::kTableOffset));
+      if (table->IsHashTable()) {
+        VisitEphemeronTable(ObjectHashTable::cast(table));
+      }
+      // TODO(ulan): implement iteration of strong fields.
+      // The main thread also links the collection into the list of
+      // encountered weak collections and marks the table.
+      bailout_.Push(object);
+    }
     return 0;
   }
 
+  // Marks the values of the entries with marked keys and defers the other
+  // entries to the ephemeron worklist. The slots of the table are recorded
+  // on the main thread, which scans the table again in the atomic pause.
+  void VisitEphemeronTable(ObjectHashTable* table) {
+    int capacity = table->Capacity();
+    for (int i = 0; i < capacity; i++) {
+      Ephemeron ephemeron = {table, i};
+      if (!ProcessEphemeron(ephemeron)) {
+        weak_objects_->ephemerons.Push(task_id_, ephemeron);
+      }
+    }
+  }
+
+  // Returns false if the key of the ephemeron is not marked yet.
+  bool ProcessEphemeron(const Ephemeron& ephemeron) {
+    ObjectHashTable* table = ephemeron.table;
+    Object** key_slot = table->RawFieldOfElementAt(
+        ObjectHashTable::EntryToIndex(ephemeron.entry));
+    Object* key = base::AsAtomicPointer::Relaxed_Load(key_slot);
+    // Empty and deleted entries hold oddballs.
+    if (!key->IsHeapObject() || key->IsOddball()) return true;
+    if (!marking_state_.IsBlackOrGrey(HeapObject::cast(key))) return false;
+    Object** value_slot = table->RawFieldOfElementAt(
+        ObjectHashTable::EntryToValueIndex(ephemeron.entry));
+    Object* value = base::AsAtomicPointer::Relaxed_Load(value_slot);
+    if (value->IsHeapObject()) MarkObject(HeapObject::cast(value));
+    return true;
+  }
+
+  // Retries the deferred ephemerons. Returns true if values of ephemerons
+  // were pushed onto the marking worklist.
+  bool ProcessEphemerons() {
+    std::vector<Ephemeron> pending;
+    Ephemeron ephemeron;
+    while (weak_objects_->ephemerons.Pop(task_id_, &ephemeron)) {
+      if (!ProcessEphemeron(ephemeron)) pending.push_back(ephemeron);
+    }
+    for (const Ephemeron& ephemeron : pending) {
+      weak_objects_->ephemerons.Push(task_id_, ephemeron);
+    }
+    return !shared_.IsLocalEmpty();
+  }
+
   void MarkObject(HeapObject* object) {
 #ifdef THREAD_SANITIZER
     // Perform a dummy acquire load to tell TSAN that there is no data race
@@ -368,6 +420,8 @@ void ConcurrentMarking::Run(int task_id, TaskState* task_state) {
              objects_processed < kObjectsUntilInterrupCheck) {
         HeapObject* object;
         if (!shared_->Pop(task_id, &object)) {
+          // Keys marked in the meantime make more ephemeron values live.
+          if (visitor.ProcessEphemerons()) continue;
           done = true;
           break;
         }
@@ -395,6 +449,7 @@ void ConcurrentMarking::Run(int task_id, TaskState* task_state) {
     }
     weak_objects_->weak_cells.FlushToGlobal(task_id);
     weak_objects_->transition_arrays.FlushToGlobal(task_id);
+    weak_objects_->ephemerons.FlushToGlobal(task_id);
     {
       base::LockGuard<base::Mutex> guard(&pending_lock_);
       is_pending_[task_id] = false;
@@ -0,0 +1,97 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/gc-latency-scheduler.h"
+
+#include "src/flags.h"
+#include "src/heap/gc-idle-time-handler.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/isolate.h"
+
+namespace v8 {
+namespace internal {
+
+const double GCLatencyScheduler::kMinMutatorUtilization = 0.5;
+const double GCLatencyScheduler::kMaxMutatorUtilization = 0.99;
+
+GCLatencyScheduler::GCLatencyScheduler(Heap* heap)
+    : heap_(heap),
+      target_pause_ms_(0),
+      target_mutator_utilization_(Heap::kTargetMutatorUtilization) {}
+
+void GCLatencyScheduler::SetTarget(double target_pause_ms,
+                                   double target_mutator_utilization) {
+  if (target_pause_ms <= 0) {
+    target_pause_ms_ = 0;
+    target_mutator_utilization_ = Heap::kTargetMutatorUtilization;
+    return;
+  }
+  target_pause_ms_ = target_pause_ms;
+  target_mutator_utilization_ =
+      Max(kMinMutatorUtilization,
+          Min(target_mutator_utilization, kMaxMutatorUtilization));
+  if (FLAG_trace_gc_verbose) {
+    heap_->isolate()->PrintWithTimestamp(
+        "GC latency target: pause=%.1f ms, mu=%.3f\n", target_pause_ms_,
+        target_mutator_utilization_);
+  }
+}
+
+bool GCLatencyScheduler::ShouldStartIncrementalMarking(
+    size_t old_generation_space_available) {
+  if (!enabled()) return false;
+  GCTracer* tracer = heap_->tracer();
+  bool result = ShouldStartMarking(
+      old_generation_space_available, heap_->PromotedSpaceSizeOfObjects(),
+      tracer->IncrementalMarkingSpeedInBytesPerMillisecond(),
+      tracer->OldGenerationAllocationThroughputInBytesPerMillisecond(),
+      target_mutator_utilization_);
+  if (result && FLAG_trace_mutator_utilization) {
+    heap_->isolate()->PrintWithTimestamp(
+        "Starting incremental marking for mu=%.3f with %" PRIuS
+        " KB available\n",
+        target_mutator_utilization_, old_generation_space_available / KB);
+  }
+  return result;
+}
+
+size_t GCLatencyScheduler::MaxMarkingStepSize(
+    double marking_speed_in_bytes_per_ms) {
+  DCHECK(enabled());
+  return GCIdleTimeHandler::EstimateMarkingStepSize(
+      target_pause_ms_, marking_speed_in_bytes_per_ms);
+}
+
+// For a marking phase of wall time T the collector may use T * (1 - MU),
+// where MU is the target mutator utilization. Marking L live bytes at
+// marking speed S therefore takes T = L / (S * (1 - MU)).
+double GCLatencyScheduler::EstimateMarkingWallTime(
+    size_t live_bytes, double marking_speed_in_bytes_per_ms,
+    double mutator_utilization) {
+  DCHECK_LT(mutator_utilization, 1.0);
+  if (marking_speed_in_bytes_per_ms == 0) {
+    marking_speed_in_bytes_per_ms =
+        GCIdleTimeHandler::kInitialConservativeMarkingSpeed;
+  }
+  return live_bytes /
+         (marking_speed_in_bytes_per_ms * (1.0 - mutator_utilization));
+}
+
+// During that time the mutator runs for T * MU and allocates at its
+// allocation throughput.
+bool GCLatencyScheduler::ShouldStartMarking(
+    size_t available_bytes, size_t live_bytes,
+    double marking_speed_in_bytes_per_ms,
+    double allocation_throughput_in_bytes_per_ms, double mutator_utilization) {
+  if (allocation_throughput_in_bytes_per_ms == 0) return false;
+  double wall_time = EstimateMarkingWallTime(
+      live_bytes, marking_speed_in_bytes_per_ms, mutator_utilization);
+  double allocated_bytes =
+      wall_time * mutator_utilization * allocation_throughput_in_bytes_per_ms;
+  return allocated_bytes >= available_bytes;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,76 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_GC_LATENCY_SCHEDULER_H_
+#define V8_HEAP_GC_LATENCY_SCHEDULER_H_
+
+#include "src/base/macros.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// The latency scheduler paces old generation garbage collection for
+// embedders that do not send idle notifications. The embedder provides a
+// pause time target and a target mutator utilization, i.e. the fraction of
+// wall time the mutator should get while the collector is active, through
+// v8::Isolate::SetGCLatencyTarget.
+//
+// Based on the marking speed and the old generation allocation throughput
+// recorded by the GCTracer, the scheduler
+// - starts incremental marking early enough for it to finish at the target
+//   mutator utilization before the old generation limit is reached,
+// - bounds incremental marking steps by the pause time target,
+// - sizes the heap growing factor for the target mutator utilization.
+class V8_EXPORT_PRIVATE GCLatencyScheduler {
+ public:
+  explicit GCLatencyScheduler(Heap* heap);
+
+  // A non-positive pause time target disables the scheduler.
+  void SetTarget(double target_pause_ms, double target_mutator_utilization);
+
+  bool enabled() const { return target_pause_ms_ > 0; }
+  double target_pause_ms() const { return target_pause_ms_; }
+  double target_mutator_utilization() const {
+    return target_mutator_utilization_;
+  }
+
+  // Returns true if incremental marking has to start now in order to finish
+  // before the remaining old generation space is used up.
+  bool ShouldStartIncrementalMarking(size_t old_generation_space_available);
+
+  // Returns the maximum number of bytes a single incremental marking step may
+  // process without exceeding the pause time target.
+  size_t MaxMarkingStepSize(double marking_speed_in_bytes_per_ms);
+
+  // Estimates the wall time incremental marking of |live_bytes| takes if the
+  // mutator keeps |mutator_utilization| of the time.
+  static double EstimateMarkingWallTime(size_t live_bytes,
+                                        double marking_speed_in_bytes_per_ms,
+                                        double mutator_utilization);
+
+  // Returns true if the mutator is expected to allocate at least
+  // |available_bytes| while |live_bytes| are marked.
+  static bool ShouldStartMarking(size_t available_bytes, size_t live_bytes,
+                                 double marking_speed_in_bytes_per_ms,
+                                 double allocation_throughput_in_bytes_per_ms,
+                                 double mutator_utilization);
+
+  static const double kMinMutatorUtilization;
+  static const double kMaxMutatorUtilization;
+
+ private:
+  Heap* heap_;
+  double target_pause_ms_;
+  double target_mutator_utilization_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCLatencyScheduler);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_GC_LATENCY_SCHEDULER_H_
@@ -544,7 +544,18 @@ void GCTracer::PrintNVP() const {
           "evacuate.update_pointers.to_new_roots=%.2f "
           "evacuate.update_pointers.slots=%.2f "
           "update_marking_deque=%.2f "
-          "reset_liveness=%.2f\n",
+          "reset_liveness=%.2f "
+          "promote_in_place=%d "
+          "total_size_before=%" PRIuS
+          " "
+          "total_size_after=%" PRIuS
+          " "
+          "promoted=%" PRIuS
+          " "
+          "semi_space_copied=%" PRIuS
+          " "
+          "promotion_rate=%.1f%% "
+          "semi_space_copy_rate=%.1f%%\n",
           duration, spent_in_mutator, "mmc", current_.reduce_memory,
           current_.scopes[Scope::MINOR_MC],
           current_.scopes[Scope::MINOR_MC_SWEEPING],
@@ -563,7 +574,11 @@ void GCTracer::PrintNVP() const {
               .scopes[Scope::MINOR_MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS],
           current_.scopes[Scope::MINOR_MC_EVACUATE_UPDATE_POINTERS_SLOTS],
           current_.scopes[Scope::MINOR_MC_MARKING_DEQUE],
-          current_.scopes[Scope::MINOR_MC_RESET_LIVENESS]);
+          current_.scopes[Scope::MINOR_MC_RESET_LIVENESS],
+          FLAG_minor_mc_promote_in_place, current_.start_object_size,
+          current_.end_object_size, heap_->promoted_objects_size(),
+          heap_->semi_space_copied_object_size(), heap_->promotion_rate_,
+          heap_->semi_space_copied_rate_);
       break;
     case Event::MARK_COMPACTOR:
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -0,0 +1,134 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-memory-budget.h"
+
+#include "src/compilation-cache.h"
+#include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
+#include "src/deoptimizer.h"
+#include "src/execution.h"
+#include "src/feedback-vector.h"
+#include "src/heap/array-buffer-pool.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/memory-reducer.h"
+#include "src/isolate.h"
+
+namespace v8 {
+namespace internal {
+
+const double HeapMemoryBudget::kReduceMemoryThreshold = 0.7;
+const double HeapMemoryBudget::kFlushCachesThreshold = 0.8;
+const double HeapMemoryBudget::kDeoptimizeThreshold = 0.9;
+
+HeapMemoryBudget::HeapMemoryBudget(Heap* heap)
+    : heap_(heap),
+      budget_bytes_(0),
+      callback_(nullptr),
+      callback_data_(nullptr),
+      used_bytes_(0),
+      current_stage_(kWithinBudget),
+      applied_stage_(kWithinBudget) {}
+
+void HeapMemoryBudget::SetBudget(size_t budget_bytes,
+                                 v8::HeapMemoryBudgetCallback callback,
+                                 void* data) {
+  budget_bytes_ = budget_bytes;
+  callback_ = callback;
+  callback_data_ = data;
+  current_stage_ = kWithinBudget;
+  applied_stage_ = kWithinBudget;
+}
+
+HeapMemoryBudget::Stage HeapMemoryBudget::StageForUsage(size_t used_bytes,
+                                                        size_t budget_bytes) {
+  if (budget_bytes == 0) return kWithinBudget;
+  double ratio = static_cast<double>(used_bytes) / budget_bytes;
+  if (ratio > 1) return kExceeded;
+  if (ratio >= kDeoptimizeThreshold) return kDeoptimize;
+  if (ratio >= kFlushCachesThreshold) return kFlushCaches;
+  if (ratio >= kReduceMemoryThreshold) return kReduceMemory;
+  return kWithinBudget;
+}
+
+void HeapMemoryBudget::NotifyMarkCompact(size_t used_bytes) {
+  if (!enabled()) return;
+  used_bytes_ = used_bytes;
+  current_stage_ = StageForUsage(used_bytes, budget_bytes_);
+  if (current_stage_ == kWithinBudget) {
+    applied_stage_ = kWithinBudget;
+    return;
+  }
+  if (FLAG_trace_gc_verbose) {
+    heap_->isolate()->PrintWithTimestamp(
+        "Heap memory budget: %" PRIuS " KB of %" PRIuS " KB used, stage %d\n",
+        used_bytes / KB, budget_bytes_ / KB, current_stage_);
+  }
+  if (HasPendingStages()) {
+    heap_->isolate()->stack_guard()->RequestGC();
+  }
+}
+
+void HeapMemoryBudget::ApplyPendingStages() {
+  while (applied_stage_ < current_stage_) {
+    applied_stage_ = static_cast<Stage>(applied_stage_ + 1);
+    ApplyStage(applied_stage_);
+  }
+}
+
+void HeapMemoryBudget::ApplyStage(Stage stage) {
+  Isolate* isolate = heap_->isolate();
+  switch (stage) {
+    case kWithinBudget:
+      UNREACHABLE();
+    case kReduceMemory: {
+      if (FLAG_incremental_marking &&
+          heap_->incremental_marking()->IsStopped()) {
+        heap_->StartIncrementalMarking(
+            Heap::kReduceMemoryFootprintMask,
+            GarbageCollectionReason::kMemoryPressure);
+      }
+      MemoryReducer::Event event;
+      event.type = MemoryReducer::kPossibleGarbage;
+      event.time_ms = heap_->MonotonicallyIncreasingTimeInMs();
+      heap_->memory_reducer()->NotifyPossibleGarbage(event);
+      break;
+    }
+    case kFlushCaches:
+      isolate->compilation_cache()->Clear();
+      heap_->array_buffer_pool()->FreeAll();
+      ClearInlineCaches();
+      break;
+    case kDeoptimize:
+      if (isolate->concurrent_recompilation_enabled()) {
+        DisallowHeapAllocation no_recursive_gc;
+        isolate->optimizing_compile_dispatcher()->Flush(
+            OptimizingCompileDispatcher::BlockingBehavior::kDontBlock);
+      }
+      // Functions on the stack are deoptimized lazily, the code objects are
+      // freed by the next garbage collection.
+      Deoptimizer::DeoptimizeAll(isolate);
+      break;
+    case kExceeded:
+      if (callback_ != nullptr) {
+        callback_(reinterpret_cast<v8::Isolate*>(isolate), used_bytes_,
+                  budget_bytes_, callback_data_);
+      }
+      break;
+  }
+}
+
+void HeapMemoryBudget::ClearInlineCaches() {
+  Isolate* isolate = heap_->isolate();
+  HeapIterator iterator(heap_);
+  for (HeapObject* obj = iterator.next(); obj != nullptr;
+       obj = iterator.next()) {
+    if (obj->IsFeedbackVector()) {
+      FeedbackVector::cast(obj)->ClearSlots(isolate);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
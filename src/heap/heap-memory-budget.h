@@ -0,0 +1,85 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_MEMORY_BUDGET_H_
+#define V8_HEAP_HEAP_MEMORY_BUDGET_H_
+
+#include "include/v8.h"
+#include "src/base/macros.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// The memory budget is a soft limit on the heap size that the embedder sets
+// with v8::Isolate::SetHeapMemoryBudget. After every mark-compact the heap
+// size is compared against the budget, and each threshold that is crossed
+// enables a more expensive way of freeing memory. The stages are applied on
+// the next stack guard interrupt because they may allocate and run code that
+// is not safe to run at the end of a garbage collection.
+//
+// A stage is applied once. The stages are re-armed after the heap size falls
+// below the first threshold again, so that a heap hovering around a threshold
+// does not repeatedly throw away all caches and optimized code.
+class V8_EXPORT_PRIVATE HeapMemoryBudget {
+ public:
+  enum Stage {
+    kWithinBudget,
+    // Start memory reducing incremental marking.
+    kReduceMemory,
+    // Flush the compilation cache and the inline caches.
+    kFlushCaches,
+    // Deoptimize all optimized code.
+    kDeoptimize,
+    // Invoke the embedder callback.
+    kExceeded,
+  };
+
+  // Thresholds of the stages as fractions of the budget.
+  static const double kReduceMemoryThreshold;
+  static const double kFlushCachesThreshold;
+  static const double kDeoptimizeThreshold;
+
+  explicit HeapMemoryBudget(Heap* heap);
+
+  // A budget of 0 disables the stages.
+  void SetBudget(size_t budget_bytes, v8::HeapMemoryBudgetCallback callback,
+                 void* data);
+
+  bool enabled() const { return budget_bytes_ > 0; }
+  bool exceeded() const { return current_stage_ == kExceeded; }
+
+  // Called after a mark-compact with the size of the live objects. Requests
+  // a stack guard interrupt if a stage has to be applied.
+  void NotifyMarkCompact(size_t used_bytes);
+
+  // Applies the stages that were reached since the last call. Called from
+  // the stack guard interrupt.
+  void ApplyPendingStages();
+
+  bool HasPendingStages() const { return applied_stage_ < current_stage_; }
+
+  static Stage StageForUsage(size_t used_bytes, size_t budget_bytes);
+
+ private:
+  void ApplyStage(Stage stage);
+  void ClearInlineCaches();
+
+  Heap* heap_;
+  size_t budget_bytes_;
+  v8::HeapMemoryBudgetCallback callback_;
+  void* callback_data_;
+  size_t used_bytes_;
+  Stage current_stage_;
+  Stage applied_stage_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapMemoryBudget);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_MEMORY_BUDGET_H_
@@ -0,0 +1,153 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-statistics-recorder.h"
+
+#include <algorithm>
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/spaces-inl.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+HeapStatisticsRecorder::HeapStatisticsRecorder(Heap* heap)
+    : heap_(heap),
+      stream_(nullptr),
+      max_allocation_sites_(0),
+      has_pending_record_(false) {}
+
+void HeapStatisticsRecorder::SetStream(v8::HeapStatisticsStream* stream,
+                                       int max_allocation_sites) {
+  stream_ = stream;
+  max_allocation_sites_ = std::max(0, max_allocation_sites);
+  has_pending_record_ = false;
+}
+
+void HeapStatisticsRecorder::CollectLiveObjectStatistics() {
+  DCHECK(enabled());
+  std::fill(object_stats_, object_stats_ + arraysize(object_stats_),
+            Stats{0, 0});
+  allocation_site_stats_.clear();
+
+  MarkCompactCollector::NonAtomicMarkingState* marking_state =
+      heap_->mark_compact_collector()->non_atomic_marking_state();
+  NewSpace* new_space = heap_->new_space();
+  for (Page* p : PageRange(new_space->bottom(), new_space->top())) {
+    for (auto object_and_size :
+         LiveObjectRange<kBlackObjects>(p, marking_state->bitmap(p))) {
+      RecordLiveObject(object_and_size.first, object_and_size.second, true,
+                       1);
+    }
+  }
+  PagedSpaces spaces(heap_);
+  for (PagedSpace* space = spaces.next(); space != nullptr;
+       space = spaces.next()) {
+    // Every |stride|-th page is visited and stands for the pages in between.
+    // The offset rotates with each GC, so that all pages are visited over
+    // time.
+    const size_t pages = static_cast<size_t>(space->CountTotalPages());
+    const size_t stride = std::max<size_t>(
+        1, (pages + kMaxSampledPagesPerSpace - 1) / kMaxSampledPagesPerSpace);
+    size_t index = stride > 1 ? heap_->gc_count() % stride : 0;
+    for (Page* p : *space) {
+      if (index++ % stride != 0) continue;
+      for (auto object_and_size :
+           LiveObjectRange<kBlackObjects>(p, marking_state->bitmap(p))) {
+        RecordLiveObject(object_and_size.first, object_and_size.second, false,
+                         stride);
+      }
+    }
+  }
+  for (LargePage* p : *heap_->lo_space()) {
+    HeapObject* object = p->GetObject();
+    if (marking_state->IsBlack(object)) {
+      RecordLiveObject(object, object->Size(), false, 1);
+    }
+  }
+  has_pending_record_ = true;
+}
+
+void HeapStatisticsRecorder::RecordLiveObject(HeapObject* object, int size,
+                                              bool in_new_space,
+                                              size_t weight) {
+  Map* map = object->map();
+  InstanceType type = map->instance_type();
+  object_stats_[type].count += weight;
+  object_stats_[type].bytes += weight * size;
+  if (!in_new_space || !AllocationSite::CanTrack(type)) return;
+  // Young objects still carry the memento of the site they were allocated
+  // from. Sites are only used as keys here, the addresses are reported as
+  // opaque ids.
+  AllocationMemento* memento =
+      heap_->FindAllocationMemento<Heap::kForGC>(map, object);
+  if (memento == nullptr || !memento->IsValid()) return;
+  Address site = memento->GetAllocationSite()->address();
+  Stats& stats = allocation_site_stats_[site];
+  stats.count++;
+  stats.bytes += size;
+}
+
+void HeapStatisticsRecorder::WriteVarint(uint64_t value) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer_.push_back(byte);
+  } while (value != 0);
+}
+
+void HeapStatisticsRecorder::WriteRecord() {
+  if (!has_pending_record_ || stream_ == nullptr) return;
+  has_pending_record_ = false;
+  buffer_.clear();
+
+  WriteVarint(kRecordVersion);
+  WriteVarint(heap_->gc_count());
+
+  int type_count = 0;
+  for (const Stats& stats : object_stats_) {
+    if (stats.count > 0) type_count++;
+  }
+  WriteVarint(type_count);
+  for (int type = 0; type <= LAST_TYPE; type++) {
+    if (object_stats_[type].count == 0) continue;
+    WriteVarint(type);
+    WriteVarint(object_stats_[type].count);
+    WriteVarint(object_stats_[type].bytes);
+  }
+
+  std::vector<std::pair<Address, Stats>> sites(allocation_site_stats_.begin(),
+                                               allocation_site_stats_.end());
+  size_t site_count =
+      std::min(sites.size(), static_cast<size_t>(max_allocation_sites_));
+  std::partial_sort(sites.begin(), sites.begin() + site_count, sites.end(),
+                    [](const std::pair<Address, Stats>& a,
+                       const std::pair<Address, Stats>& b) {
+                      return a.second.bytes > b.second.bytes;
+                    });
+  WriteVarint(site_count);
+  for (size_t i = 0; i < site_count; i++) {
+    WriteVarint(reinterpret_cast<uintptr_t>(sites[i].first));
+    WriteVarint(sites[i].second.count);
+    WriteVarint(sites[i].second.bytes);
+  }
+  allocation_site_stats_.clear();
+
+  WriteVarint(LAST_SPACE - FIRST_SPACE + 1);
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    Space* space = heap_->space(i);
+    WriteVarint(i);
+    WriteVarint(space->CommittedMemory());
+    WriteVarint(space->SizeOfObjects());
+    WriteVarint(space->Available());
+  }
+
+  stream_->WriteRecord(buffer_.data(), buffer_.size());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,72 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_STATISTICS_RECORDER_H_
+#define V8_HEAP_HEAP_STATISTICS_RECORDER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/macros.h"
+#include "src/globals.h"
+#include "src/objects.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Produces the records of v8::HeapStatisticsStream. Unlike ObjectStats, which
+// walks all objects and attributes them to detailed sub types, the recorder
+// only visits marked objects and counts them by instance type. In large paged
+// spaces only a sample of the pages is visited and the counts are
+// extrapolated, so that the cost per garbage collection is bounded. The record
+// format is documented with v8::HeapStatisticsStream.
+class V8_EXPORT_PRIVATE HeapStatisticsRecorder {
+ public:
+  static const int kRecordVersion = 1;
+  // Paged spaces with more pages than this are sampled.
+  static const int kMaxSampledPagesPerSpace = 16;
+
+  explicit HeapStatisticsRecorder(Heap* heap);
+
+  // Passing nullptr as |stream| disables the recorder.
+  void SetStream(v8::HeapStatisticsStream* stream, int max_allocation_sites);
+  bool enabled() const { return stream_ != nullptr; }
+
+  // Counts live objects and the allocation sites of surviving young objects.
+  // Called during the mark-compact pause, after marking and before
+  // evacuation. New space and large objects are counted exactly.
+  void CollectLiveObjectStatistics();
+
+  // Emits the record of the last mark-compact, if one was collected. Called
+  // after the garbage collection has finished.
+  void WriteRecord();
+
+ private:
+  struct Stats {
+    size_t count;
+    size_t bytes;
+  };
+
+  void RecordLiveObject(HeapObject* object, int size, bool in_new_space,
+                        size_t weight);
+  void WriteVarint(uint64_t value);
+
+  Heap* heap_;
+  v8::HeapStatisticsStream* stream_;
+  int max_allocation_sites_;
+  bool has_pending_record_;
+  Stats object_stats_[LAST_TYPE + 1];
+  std::unordered_map<Address, Stats> allocation_site_stats_;
+  std::vector<uint8_t> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapStatisticsRecorder);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_STATISTICS_RECORDER_H_
@@ -23,13 +23,17 @@
 #include "src/deoptimizer.h"
 #include "src/feedback-vector.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-pool.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/barrier.h"
 #include "src/heap/code-stats.h"
 #include "src/heap/concurrent-marking.h"
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/gc-idle-time-handler.h"
+#include "src/heap/gc-latency-scheduler.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-memory-budget.h"
+#include "src/heap/heap-statistics-recorder.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/item-parallel-job.h"
 #include "src/heap/mark-compact-inl.h"
@@ -172,6 +176,7 @@ Heap::Heap()
       code_space_(NULL),
       map_space_(NULL),
       lo_space_(NULL),
+      new_lo_space_(nullptr),
       gc_state_(NOT_IN_GC),
       gc_post_processing_depth_(0),
       allocations_count_(0),
@@ -205,6 +210,10 @@ Heap::Heap()
       concurrent_marking_(nullptr),
       gc_idle_time_handler_(nullptr),
       memory_reducer_(nullptr),
+      gc_latency_scheduler_(nullptr),
+      array_buffer_pool_(nullptr),
+      heap_statistics_recorder_(nullptr),
+      heap_memory_budget_(nullptr),
       live_object_stats_(nullptr),
       dead_object_stats_(nullptr),
       scavenge_job_(nullptr),
@@ -266,7 +275,8 @@ size_t Heap::CommittedOldGenerationMemory() {
 size_t Heap::CommittedMemory() {
   if (!HasBeenSetUp()) return 0;
 
-  return new_space_->CommittedMemory() + CommittedOldGenerationMemory();
+  return new_space_->CommittedMemory() + new_lo_space_->Size() +
+         CommittedOldGenerationMemory();
 }
 
 
@@ -277,7 +287,8 @@ size_t Heap::CommittedPhysicalMemory() {
          old_space_->CommittedPhysicalMemory() +
          code_space_->CommittedPhysicalMemory() +
          map_space_->CommittedPhysicalMemory() +
-         lo_space_->CommittedPhysicalMemory();
+         lo_space_->CommittedPhysicalMemory() +
+         new_lo_space_->CommittedPhysicalMemory();
 }
 
 size_t Heap::CommittedMemoryExecutable() {
@@ -310,7 +321,7 @@ size_t Heap::Available() {
 
 bool Heap::HasBeenSetUp() {
   return old_space_ != NULL && code_space_ != NULL && map_space_ != NULL &&
-         lo_space_ != NULL;
+         lo_space_ != NULL && new_lo_space_ != nullptr;
 }
 
 
@@ -426,6 +437,14 @@ void Heap::PrintShortHeapStatistics() {
                          ", committed: %6" PRIuS " KB\n",
                lo_space_->SizeOfObjects() / KB, lo_space_->Available() / KB,
                lo_space_->CommittedMemory() / KB);
+  PrintIsolate(isolate_, "New large object space, used: %6" PRIuS
+                         " KB"
+                         ", available: %6" PRIuS
+                         " KB"
+                         ", committed: %6" PRIuS " KB\n",
+               new_lo_space_->SizeOfObjects() / KB,
+               new_lo_space_->Available() / KB,
+               new_lo_space_->CommittedMemory() / KB);
   PrintIsolate(isolate_, "All spaces,         used: %6" PRIuS
                          " KB"
                          ", available: %6" PRIuS
@@ -633,6 +652,8 @@ const char* Heap::GetSpaceName(int idx) {
       return "code_space";
     case LO_SPACE:
       return "large_object_space";
+    case NEW_LO_SPACE:
+      return "new_large_object_space";
     default:
       UNREACHABLE();
   }
@@ -994,6 +1015,9 @@ class GCCallbacksScope {
 
 
 void Heap::HandleGCRequest() {
+  if (heap_memory_budget_->HasPendingStages()) {
+    heap_memory_budget_->ApplyPendingStages();
+  }
   if (HighMemoryPressure()) {
     incremental_marking()->reset_request_type();
     CheckMemoryPressure();
@@ -1119,6 +1143,7 @@ void Heap::CollectAllAvailableGarbage(GarbageCollectionReason gc_reason) {
   set_current_gc_flags(kNoGCFlags);
   new_space_->Shrink();
   UncommitFromSpace();
+  array_buffer_pool_->FreeAll();
 }
 
 void Heap::ReportExternalMemoryPressure() {
@@ -1255,6 +1280,15 @@ bool Heap::CollectGarbage(AllocationSpace space,
     tracer()->Stop(collector);
   }
 
+  if (collector == MARK_COMPACTOR && FLAG_string_deduplication) {
+    mark_compact_collector()->DeduplicateStrings();
+  }
+
+  if (collector == MARK_COMPACTOR) {
+    heap_statistics_recorder_->WriteRecord();
+    heap_memory_budget_->NotifyMarkCompact(SizeOfObjects());
+  }
+
   if (collector == MARK_COMPACTOR &&
       (gc_callback_flags & (kGCCallbackFlagForced |
                             kGCCallbackFlagCollectAllAvailableGarbage)) != 0) {
@@ -1684,6 +1718,12 @@ void Heap::MarkCompact() {
 
   uint64_t size_of_objects_before_gc = SizeOfObjects();
 
+  {
+    // The full collector does not distinguish young large objects.
+    ConcurrentMarking::PauseScope pause_scope(concurrent_marking());
+    PromoteNewLargeObjects();
+  }
+
   mark_compact_collector()->Prepare();
 
   ms_count_++;
@@ -1812,6 +1852,8 @@ void Heap::EvacuateYoungGeneration() {
     if (incremental_marking()->IsMarking())
       mark_compact_collector()->RecordLiveSlotsOnPage(p);
   }
+  const size_t promoted_large_objects_size = new_lo_space()->SizeOfObjects();
+  PromoteNewLargeObjects();
 
   // Reset new space.
   if (!new_space()->Rebalance()) {
@@ -1824,8 +1866,10 @@ void Heap::EvacuateYoungGeneration() {
   external_string_table_.PromoteAllNewSpaceStrings();
   // GlobalHandles are updated in PostGarbageCollectonProcessing
 
-  IncrementYoungSurvivorsCounter(new_space()->Size());
-  IncrementPromotedObjectsSize(new_space()->Size());
+  IncrementYoungSurvivorsCounter(new_space()->Size() +
+                                 promoted_large_objects_size);
+  IncrementPromotedObjectsSize(new_space()->Size() +
+                               promoted_large_objects_size);
   IncrementSemiSpaceCopiedObjectSize(0);
 
   LOG(isolate_, ResourceEvent("scavenge", "end"));
@@ -1917,6 +1961,24 @@ class PageScavengingItem final : public ScavengingItem {
   MemoryChunk* const chunk_;
 };
 
+class GlobalHandlesScavengingItem final : public ScavengingItem {
+ public:
+  GlobalHandlesScavengingItem(Heap* heap, size_t start, size_t end)
+      : heap_(heap), start_(start), end_(end) {}
+  virtual ~GlobalHandlesScavengingItem() {}
+
+  void Process(Scavenger* scavenger) final {
+    RootScavengeVisitor visitor(heap_, scavenger);
+    heap_->isolate()->global_handles()->IterateNewSpaceStrongAndDependentRoots(
+        &visitor, start_, end_);
+  }
+
+ private:
+  Heap* const heap_;
+  const size_t start_;
+  const size_t end_;
+};
+
 int Heap::NumberOfScavengeTasks() {
   if (!FLAG_parallel_scavenge) return 1;
   const int num_scavenge_tasks =
@@ -1955,6 +2017,7 @@ void Heap::Scavenge() {
   // live objects.
   new_space_->Flip();
   new_space_->ResetAllocationInfo();
+  new_lo_space_->Flip();
 
   ItemParallelJob job(isolate()->cancelable_task_manager(),
                       &parallel_scavenge_semaphore_);
@@ -1976,6 +2039,17 @@ void Heap::Scavenge() {
         job.AddItem(new PageScavengingItem(this, chunk));
       });
 
+  // Strong and dependent new space global handles are scanned by the
+  // scavenging tasks in batches.
+  const size_t kGlobalHandlesBatchSize = 1000;
+  const size_t new_space_nodes =
+      isolate()->global_handles()->NumberOfNewSpaceNodes();
+  for (size_t start = 0; start < new_space_nodes;
+       start += kGlobalHandlesBatchSize) {
+    size_t end = Min(start + kGlobalHandlesBatchSize, new_space_nodes);
+    job.AddItem(new GlobalHandlesScavengingItem(this, start, end));
+  }
+
   RootScavengeVisitor root_scavenge_visitor(this, scavengers[kMainThreadId]);
 
   {
@@ -1988,7 +2062,7 @@ void Heap::Scavenge() {
   {
     // Copy roots.
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_ROOTS);
-    IterateRoots(&root_scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    IterateRoots(&root_scavenge_visitor, VISIT_ALL_IN_PARALLEL_SCAVENGE);
   }
   {
     // Weak collections are held strongly by the Scavenger.
@@ -2018,6 +2092,8 @@ void Heap::Scavenge() {
     delete scavengers[i];
   }
 
+  HandleSurvivingNewLargeObjects();
+
   UpdateNewSpaceReferencesInExternalStringTable(
       &UpdateNewSpaceReferenceInExternalStringTableEntry);
 
@@ -2030,6 +2106,9 @@ void Heap::Scavenge() {
                              new_space()->FromSpaceEnd())) {
       concurrent_marking()->ClearLiveness(p);
     }
+    for (LargePage* p : *new_lo_space()) {
+      concurrent_marking()->ClearLiveness(p);
+    }
   }
 
   ScavengeWeakObjectRetainer weak_object_retainer(this);
@@ -2040,6 +2119,9 @@ void Heap::Scavenge() {
 
   ArrayBufferTracker::FreeDeadInNewSpace(this);
 
+  // The remaining young large objects are dead.
+  new_lo_space_->FreeAllObjects();
+
   RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(this, [](MemoryChunk* chunk) {
     if (chunk->SweepingDone()) {
       RememberedSet<OLD_TO_NEW>::FreeEmptyBuckets(chunk);
@@ -2060,6 +2142,63 @@ void Heap::Scavenge() {
   SetGCState(NOT_IN_GC);
 }
 
+void Heap::MergeSurvivingNewLargeObjects(
+    const SurvivingNewLargeObjects& objects) {
+  surviving_new_large_objects_.insert(surviving_new_large_objects_.end(),
+                                      objects.begin(), objects.end());
+}
+
+void Heap::HandleSurvivingNewLargeObjects() {
+  for (auto& object_and_map : surviving_new_large_objects_) {
+    HeapObject* object = object_and_map.first;
+    Map* map = object_and_map.second;
+    object->set_map_word(MapWord::FromMap(map));
+    lo_space_->PromoteNewLargeObject(
+        static_cast<LargePage*>(MemoryChunk::FromAddress(object->address())));
+  }
+  surviving_new_large_objects_.clear();
+}
+
+class PromotedLargeObjectSlotsVisitor final : public ObjectVisitor {
+ public:
+  PromotedLargeObjectSlotsVisitor(Heap* heap, bool record_slots)
+      : heap_(heap), record_slots_(record_slots) {}
+
+  void VisitPointers(HeapObject* host, Object** start, Object** end) final {
+    for (Object** p = start; p < end; p++) {
+      Object* value = *p;
+      if (!value->IsHeapObject()) continue;
+      if (heap_->InNewSpace(value)) {
+        RememberedSet<OLD_TO_NEW>::Insert(
+            MemoryChunk::FromAddress(host->address()),
+            reinterpret_cast<Address>(p));
+      } else if (record_slots_) {
+        heap_->mark_compact_collector()->RecordSlot(host, p, value);
+      }
+    }
+  }
+
+ private:
+  Heap* const heap_;
+  const bool record_slots_;
+};
+
+void Heap::PromoteNewLargeObjects() {
+  while (new_lo_space_->first_page() != nullptr) {
+    LargePage* page = new_lo_space_->first_page();
+    HeapObject* object = page->GetObject();
+    lo_space_->PromoteNewLargeObject(page);
+    // Young objects have no recorded slots. Black objects are not revisited
+    // by the marker, so their slots into evacuation candidates are recorded
+    // here as well.
+    const bool record_slots =
+        incremental_marking()->IsCompacting() &&
+        incremental_marking()->marking_state()->IsBlack(object);
+    PromotedLargeObjectSlotsVisitor visitor(this, record_slots);
+    object->IterateBody(&visitor);
+  }
+}
+
 void Heap::ComputeFastPromotionMode(double survival_rate) {
   const size_t survived_in_new_space =
       survived_last_scavenge_ * 100 / new_space_->Capacity();
@@ -2852,7 +2991,7 @@ bool Heap::CanMoveObjectStart(HeapObject* object) {
 
   Address address = object->address();
 
-  if (lo_space()->Contains(object)) return false;
+  if (IsLargeObject(object)) return false;
 
   // We can move the object start if the page was already swept.
   return Page::FromAddress(address)->SweepingDone();
@@ -2860,7 +2999,12 @@ bool Heap::CanMoveObjectStart(HeapObject* object) {
 
 bool Heap::IsImmovable(HeapObject* object) {
   MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
-  return chunk->NeverEvacuate() || chunk->owner()->identity() == LO_SPACE;
+  return chunk->NeverEvacuate() || chunk->owner()->identity() == LO_SPACE ||
+         chunk->owner()->identity() == NEW_LO_SPACE;
+}
+
+bool Heap::IsLargeObject(HeapObject* object) {
+  return lo_space()->Contains(object) || new_lo_space()->Contains(object);
 }
 
 FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
@@ -2876,7 +3020,7 @@ FixedArrayBase* Heap::LeftTrimFixedArray(FixedArrayBase* object,
   // For now this trick is only applied to objects in new and paged space.
   // In large object space the object's start must coincide with chunk
   // and thus the trick is just not applicable.
-  DCHECK(!lo_space()->Contains(object));
+  DCHECK(!IsLargeObject(object));
   DCHECK(object->map() != fixed_cow_array_map());
 
   STATIC_ASSERT(FixedArrayBase::kMapOffset == 0);
@@ -2963,7 +3107,7 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // We do not create a filler for objects in large object space.
   // TODO(hpayer): We should shrink the large object page if the size
   // of the object changed significantly.
-  if (!lo_space()->Contains(object)) {
+  if (!IsLargeObject(object)) {
     HeapObject* filler =
         CreateFillerObjectAt(new_end, bytes_to_trim, ClearRecordedSlots::kYes);
     DCHECK_NOT_NULL(filler);
@@ -4307,6 +4451,7 @@ class MemoryPressureInterruptTask : public CancelableTask {
 
 void Heap::CheckMemoryPressure() {
   if (HighMemoryPressure()) {
+    array_buffer_pool_->FreeAll();
     if (isolate()->concurrent_recompilation_enabled()) {
       // The optimizing compiler may be unnecessarily holding on to memory.
       DisallowHeapAllocation no_recursive_gc;
@@ -4516,7 +4661,7 @@ bool Heap::Contains(HeapObject* value) {
   return HasBeenSetUp() &&
          (new_space_->ToSpaceContains(value) || old_space_->Contains(value) ||
           code_space_->Contains(value) || map_space_->Contains(value) ||
-          lo_space_->Contains(value));
+          lo_space_->Contains(value) || new_lo_space_->Contains(value));
 }
 
 bool Heap::ContainsSlow(Address addr) {
@@ -4526,7 +4671,8 @@ bool Heap::ContainsSlow(Address addr) {
   return HasBeenSetUp() &&
          (new_space_->ToSpaceContainsSlow(addr) ||
           old_space_->ContainsSlow(addr) || code_space_->ContainsSlow(addr) ||
-          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr));
+          map_space_->ContainsSlow(addr) || lo_space_->ContainsSlow(addr) ||
+          new_lo_space_->ContainsSlow(addr));
 }
 
 bool Heap::InSpace(HeapObject* value, AllocationSpace space) {
@@ -4546,6 +4692,8 @@ bool Heap::InSpace(HeapObject* value, AllocationSpace space) {
       return map_space_->Contains(value);
     case LO_SPACE:
       return lo_space_->Contains(value);
+    case NEW_LO_SPACE:
+      return new_lo_space_->Contains(value);
   }
   UNREACHABLE();
 }
@@ -4567,6 +4715,8 @@ bool Heap::InSpaceSlow(Address addr, AllocationSpace space) {
       return map_space_->ContainsSlow(addr);
     case LO_SPACE:
       return lo_space_->ContainsSlow(addr);
+    case NEW_LO_SPACE:
+      return new_lo_space_->ContainsSlow(addr);
   }
   UNREACHABLE();
 }
@@ -4579,6 +4729,7 @@ bool Heap::IsValidAllocationSpace(AllocationSpace space) {
     case CODE_SPACE:
     case MAP_SPACE:
     case LO_SPACE:
+    case NEW_LO_SPACE:
       return true;
     default:
       return false;
@@ -4626,6 +4777,7 @@ void Heap::Verify() {
   code_space_->Verify(&no_dirty_regions_visitor);
 
   lo_space_->Verify();
+  new_lo_space_->Verify();
 
   mark_compact_collector()->VerifyWeakEmbeddedObjectsInCode();
 }
@@ -4765,6 +4917,7 @@ void Heap::IterateRoots(RootVisitor* v, VisitMode mode) {
 
 void Heap::IterateWeakRoots(RootVisitor* v, VisitMode mode) {
   const bool isMinorGC = mode == VISIT_ALL_IN_SCAVENGE ||
+                         mode == VISIT_ALL_IN_PARALLEL_SCAVENGE ||
                          mode == VISIT_ALL_IN_MINOR_MC_MARK ||
                          mode == VISIT_ALL_IN_MINOR_MC_UPDATE;
   v->VisitRootPointer(Root::kStringTable, reinterpret_cast<Object**>(
@@ -4836,6 +4989,7 @@ class FixStaleLeftTrimmedHandlesVisitor : public RootVisitor {
 
 void Heap::IterateStrongRoots(RootVisitor* v, VisitMode mode) {
   const bool isMinorGC = mode == VISIT_ALL_IN_SCAVENGE ||
+                         mode == VISIT_ALL_IN_PARALLEL_SCAVENGE ||
                          mode == VISIT_ALL_IN_MINOR_MC_MARK ||
                          mode == VISIT_ALL_IN_MINOR_MC_UPDATE;
   v->VisitRootPointers(Root::kStrongRootList, &roots_[0],
@@ -4888,6 +5042,9 @@ void Heap::IterateStrongRoots(RootVisitor* v, VisitMode mode) {
     case VISIT_ALL_IN_SCAVENGE:
       isolate_->global_handles()->IterateNewSpaceStrongAndDependentRoots(v);
       break;
+    case VISIT_ALL_IN_PARALLEL_SCAVENGE:
+      // Global handles are processed by the scavenging tasks.
+      break;
     case VISIT_ALL_IN_MINOR_MC_MARK:
       // Global handles are processed manually be the minor MC.
       break;
@@ -5154,13 +5311,14 @@ const double Heap::kTargetMutatorUtilization = 0.97;
 //   F * (R * (1 - MU) - MU) / (R * (1 - MU)) = 1
 //   F = R * (1 - MU) / (R * (1 - MU) - MU)
 double Heap::HeapGrowingFactor(double gc_speed, double mutator_speed,
-                               double max_factor) {
+                               double max_factor,
+                               double target_mutator_utilization) {
   DCHECK(max_factor >= kMinHeapGrowingFactor);
   DCHECK(max_factor <= kMaxHeapGrowingFactor);
   if (gc_speed == 0 || mutator_speed == 0) return max_factor;
 
   const double speed_ratio = gc_speed / mutator_speed;
-  const double mu = kTargetMutatorUtilization;
+  const double mu = target_mutator_utilization;
 
   const double a = speed_ratio * (1 - mu);
   const double b = speed_ratio * (1 - mu) - mu;
@@ -5224,14 +5382,14 @@ size_t Heap::MinimumAllocationLimitGrowingStep() {
 void Heap::SetOldGenerationAllocationLimit(size_t old_gen_size, double gc_speed,
                                            double mutator_speed) {
   double max_factor = MaxHeapGrowingFactor(max_old_generation_size_);
-  double factor = HeapGrowingFactor(gc_speed, mutator_speed, max_factor);
+  const double mu = gc_latency_scheduler_->target_mutator_utilization();
+  double factor = HeapGrowingFactor(gc_speed, mutator_speed, max_factor, mu);
 
   if (FLAG_trace_gc_verbose) {
     isolate_->PrintWithTimestamp(
         "Heap growing factor %.1f based on mu=%.3f, speed_ratio=%.f "
         "(gc=%.f, mutator=%.f)\n",
-        factor, kTargetMutatorUtilization, gc_speed / mutator_speed, gc_speed,
-        mutator_speed);
+        factor, mu, gc_speed / mutator_speed, gc_speed, mutator_speed);
   }
 
   if (memory_reducer_->ShouldGrowHeapSlowly() ||
@@ -5261,7 +5419,9 @@ void Heap::DampenOldGenerationAllocationLimit(size_t old_gen_size,
                                               double gc_speed,
                                               double mutator_speed) {
   double max_factor = MaxHeapGrowingFactor(max_old_generation_size_);
-  double factor = HeapGrowingFactor(gc_speed, mutator_speed, max_factor);
+  double factor =
+      HeapGrowingFactor(gc_speed, mutator_speed, max_factor,
+                        gc_latency_scheduler_->target_mutator_utilization());
   size_t limit = CalculateOldGenerationAllocationLimit(factor, old_gen_size);
   if (limit < old_generation_allocation_limit_) {
     if (FLAG_trace_gc_verbose) {
@@ -5335,19 +5495,23 @@ Heap::IncrementalMarkingLimit Heap::IncrementalMarkingLimitReached() {
     return IncrementalMarkingLimit::kHardLimit;
   }
   size_t old_generation_space_available = OldGenerationSpaceAvailable();
-  if (old_generation_space_available > new_space_->Capacity()) {
-    return IncrementalMarkingLimit::kNoLimit;
-  }
-  if (ShouldOptimizeForMemoryUsage()) {
-    return IncrementalMarkingLimit::kHardLimit;
-  }
-  if (ShouldOptimizeForLoadTime()) {
-    return IncrementalMarkingLimit::kNoLimit;
+  if (old_generation_space_available <= new_space_->Capacity()) {
+    if (ShouldOptimizeForMemoryUsage()) {
+      return IncrementalMarkingLimit::kHardLimit;
+    }
+    if (!ShouldOptimizeForLoadTime()) {
+      return old_generation_space_available == 0
+                 ? IncrementalMarkingLimit::kHardLimit
+                 : IncrementalMarkingLimit::kSoftLimit;
+    }
   }
-  if (old_generation_space_available == 0) {
-    return IncrementalMarkingLimit::kHardLimit;
+  if (gc_latency_scheduler_->ShouldStartIncrementalMarking(
+          old_generation_space_available)) {
+    // It would be too early otherwise, but marking has to start now to finish
+    // at the target mutator utilization.
+    return IncrementalMarkingLimit::kSoftLimit;
   }
-  return IncrementalMarkingLimit::kSoftLimit;
+  return IncrementalMarkingLimit::kNoLimit;
 }
 
 void Heap::EnableInlineAllocation() {
@@ -5443,6 +5607,9 @@ bool Heap::SetUp() {
   space_[LO_SPACE] = lo_space_ = new LargeObjectSpace(this, LO_SPACE);
   if (!lo_space_->SetUp()) return false;
 
+  space_[NEW_LO_SPACE] = new_lo_space_ = new NewLargeObjectSpace(this);
+  if (!new_lo_space_->SetUp()) return false;
+
   // Set up the seed that is used to randomize the string hash function.
   DCHECK(hash_seed() == 0);
   if (FLAG_randomize_hashes) InitializeHashSeed();
@@ -5456,6 +5623,10 @@ bool Heap::SetUp() {
   minor_mark_compact_collector_ = new MinorMarkCompactCollector(this);
   gc_idle_time_handler_ = new GCIdleTimeHandler();
   memory_reducer_ = new MemoryReducer(this);
+  gc_latency_scheduler_ = new GCLatencyScheduler(this);
+  array_buffer_pool_ = new ArrayBufferPool(this);
+  heap_statistics_recorder_ = new HeapStatisticsRecorder(this);
+  heap_memory_budget_ = new HeapMemoryBudget(this);
   if (V8_UNLIKELY(FLAG_gc_stats)) {
     live_object_stats_ = new ObjectStats(this);
     dead_object_stats_ = new ObjectStats(this);
@@ -5594,6 +5765,11 @@ void Heap::TearDown() {
     minor_mark_compact_collector_ = nullptr;
   }
 
+  // Backing stores freed while tearing down the spaces bypass the pool.
+  if (array_buffer_pool_ != nullptr) {
+    array_buffer_pool_->TearDown();
+  }
+
   delete incremental_marking_;
   incremental_marking_ = nullptr;
 
@@ -5609,6 +5785,15 @@ void Heap::TearDown() {
     memory_reducer_ = nullptr;
   }
 
+  delete gc_latency_scheduler_;
+  gc_latency_scheduler_ = nullptr;
+
+  delete heap_statistics_recorder_;
+  heap_statistics_recorder_ = nullptr;
+
+  delete heap_memory_budget_;
+  heap_memory_budget_ = nullptr;
+
   if (live_object_stats_ != nullptr) {
     delete live_object_stats_;
     live_object_stats_ = nullptr;
@@ -5657,6 +5842,12 @@ void Heap::TearDown() {
     lo_space_ = NULL;
   }
 
+  if (new_lo_space_ != nullptr) {
+    new_lo_space_->TearDown();
+    delete new_lo_space_;
+    new_lo_space_ = nullptr;
+  }
+
   store_buffer()->TearDown();
 
   memory_allocator()->TearDown();
@@ -5673,6 +5864,9 @@ void Heap::TearDown() {
 
   delete memory_allocator_;
   memory_allocator_ = nullptr;
+
+  delete array_buffer_pool_;
+  array_buffer_pool_ = nullptr;
 }
 
 void Heap::AddGCPrologueCallback(v8::Isolate::GCCallbackWithData callback,
@@ -5933,6 +6127,8 @@ Space* AllSpaces::next() {
       return heap_->map_space();
     case LO_SPACE:
       return heap_->lo_space();
+    case NEW_LO_SPACE:
+      return heap_->new_lo_space();
     default:
       return NULL;
   }
@@ -6315,6 +6511,8 @@ const char* AllocationSpaceName(AllocationSpace space) {
       return "MAP_SPACE";
     case LO_SPACE:
       return "LO_SPACE";
+    case NEW_LO_SPACE:
+      return "NEW_LO_SPACE";
     default:
       UNREACHABLE();
   }
@@ -6377,6 +6575,7 @@ bool Heap::AllowedToBeMigrated(HeapObject* obj, AllocationSpace dst) {
       return dst == src && type == CODE_TYPE;
     case MAP_SPACE:
     case LO_SPACE:
+    case NEW_LO_SPACE:
       return false;
   }
   UNREACHABLE();
@@ -361,13 +361,17 @@ using v8::MemoryPressureLevel;
   } while (false)
 
 class AllocationObserver;
+class ArrayBufferPool;
 class ArrayBufferTracker;
 class ConcurrentMarking;
 class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
+class GCLatencyScheduler;
 class GCTracer;
+class HeapMemoryBudget;
 class HeapObjectsFilter;
+class HeapStatisticsRecorder;
 class HeapStats;
 class HistogramTimer;
 class Isolate;
@@ -560,6 +564,9 @@ class Heap {
 
   using PretenuringFeedbackMap = std::unordered_map<AllocationSite*, size_t>;
 
+  // Young large objects that survived a scavenge, together with their maps.
+  using SurvivingNewLargeObjects = std::vector<std::pair<HeapObject*, Map*>>;
+
   // Taking this mutex prevents the GC from entering a phase that relocates
   // object references.
   base::Mutex* relocation_mutex() { return &relocation_mutex_; }
@@ -602,7 +609,7 @@ class Heap {
   static const double kMaxHeapGrowingFactorMemoryConstrained;
   static const double kMaxHeapGrowingFactorIdle;
   static const double kConservativeHeapGrowingFactor;
-  static const double kTargetMutatorUtilization;
+  V8_EXPORT_PRIVATE static const double kTargetMutatorUtilization;
 
   static const int kNoGCFlags = 0;
   static const int kReduceMemoryFootprintMask = 1;
@@ -685,9 +692,9 @@ class Heap {
 
   V8_EXPORT_PRIVATE static double MaxHeapGrowingFactor(
       size_t max_old_generation_size);
-  V8_EXPORT_PRIVATE static double HeapGrowingFactor(double gc_speed,
-                                                    double mutator_speed,
-                                                    double max_factor);
+  V8_EXPORT_PRIVATE static double HeapGrowingFactor(
+      double gc_speed, double mutator_speed, double max_factor,
+      double target_mutator_utilization = kTargetMutatorUtilization);
 
   // Copy block of memory from src to dst. Size of block should be aligned
   // by pointer size.
@@ -720,6 +727,9 @@ class Heap {
 
   static bool IsImmovable(HeapObject* object);
 
+  // Returns true for objects in the old or the young large object space.
+  bool IsLargeObject(HeapObject* object);
+
   // Trim the given array from the left. Note that this relocates the object
   // start and hence is only valid if there is only a single reference to it.
   FixedArrayBase* LeftTrimFixedArray(FixedArrayBase* obj, int elements_to_trim);
@@ -959,6 +969,7 @@ class Heap {
   OldSpace* code_space() { return code_space_; }
   MapSpace* map_space() { return map_space_; }
   LargeObjectSpace* lo_space() { return lo_space_; }
+  NewLargeObjectSpace* new_lo_space() { return new_lo_space_; }
 
   inline PagedSpace* paged_space(int idx);
   inline Space* space(int idx);
@@ -1186,6 +1197,18 @@ class Heap {
 
   IncrementalMarking* incremental_marking() { return incremental_marking_; }
 
+  MemoryReducer* memory_reducer() { return memory_reducer_; }
+
+  GCLatencyScheduler* gc_latency_scheduler() { return gc_latency_scheduler_; }
+
+  ArrayBufferPool* array_buffer_pool() { return array_buffer_pool_; }
+
+  HeapStatisticsRecorder* heap_statistics_recorder() {
+    return heap_statistics_recorder_;
+  }
+
+  HeapMemoryBudget* heap_memory_budget() { return heap_memory_budget_; }
+
   // ===========================================================================
   // Concurrent marking API. ===================================================
   // ===========================================================================
@@ -1491,6 +1514,14 @@ class Heap {
   void MergeAllocationSitePretenuringFeedback(
       const PretenuringFeedbackMap& local_pretenuring_feedback);
 
+  // ===========================================================================
+  // Young large objects. ======================================================
+  // ===========================================================================
+
+  // Collects the young large objects a scavenger found alive. They are moved
+  // to the old generation at the end of the scavenge.
+  void MergeSurvivingNewLargeObjects(const SurvivingNewLargeObjects& objects);
+
   // ===========================================================================
   // Retaining path tracking. ==================================================
   // ===========================================================================
@@ -1840,6 +1871,14 @@ class Heap {
   void Scavenge();
   void EvacuateYoungGeneration();
 
+  // Restores the maps of the young large objects that survived the scavenge
+  // and moves their pages to the large object space.
+  void HandleSurvivingNewLargeObjects();
+
+  // Moves all young large objects to the large object space, e.g. before a
+  // full garbage collection.
+  void PromoteNewLargeObjects();
+
   void UpdateNewSpaceReferencesInExternalStringTable(
       ExternalStringTableUpdaterCallback updater_func);
 
@@ -2253,6 +2292,7 @@ class Heap {
   OldSpace* code_space_;
   MapSpace* map_space_;
   LargeObjectSpace* lo_space_;
+  NewLargeObjectSpace* new_lo_space_;
   // Map from the space id to the space.
   Space* space_[LAST_SPACE + 1];
   HeapState gc_state_;
@@ -2356,6 +2396,14 @@ class Heap {
 
   MemoryReducer* memory_reducer_;
 
+  GCLatencyScheduler* gc_latency_scheduler_;
+
+  ArrayBufferPool* array_buffer_pool_;
+
+  HeapStatisticsRecorder* heap_statistics_recorder_;
+
+  HeapMemoryBudget* heap_memory_budget_;
+
   ObjectStats* live_object_stats_;
   ObjectStats* dead_object_stats_;
 
@@ -2384,6 +2432,8 @@ class Heap {
   // forwarding pointers.
   PretenuringFeedbackMap global_pretenuring_feedback_;
 
+  SurvivingNewLargeObjects surviving_new_large_objects_;
+
   char trace_ring_buffer_[kTraceRingBufferSize];
 
   // Used as boolean.
@@ -2446,6 +2496,7 @@ class Heap {
   friend class IncrementalMarking;
   friend class IncrementalMarkingJob;
   friend class LargeObjectSpace;
+  friend class NewLargeObjectSpace;
   friend class MarkCompactCollector;
   friend class MarkCompactCollectorBase;
   friend class MinorMarkCompactCollector;
@@ -9,6 +9,7 @@
 #include "src/conversions.h"
 #include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
+#include "src/heap/gc-latency-scheduler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/mark-compact-inl.h"
@@ -206,7 +207,8 @@ class IncrementalMarkingMarkingVisitor final
     int object_size = FixedArray::BodyDescriptor::SizeOf(map, object);
     if (chunk->IsFlagSet(MemoryChunk::HAS_PROGRESS_BAR)) {
       DCHECK(!FLAG_use_marking_progress_bar ||
-             chunk->owner()->identity() == LO_SPACE);
+             chunk->owner()->identity() == LO_SPACE ||
+             chunk->owner()->identity() == NEW_LO_SPACE);
       // When using a progress bar for large fixed arrays, scan only a chunk of
       // the array and try to push it onto the marking deque again until it is
       // fully scanned. Fall back to scanning it through to the end in case this
@@ -363,6 +365,10 @@ void IncrementalMarking::DeactivateIncrementalWriteBarrier() {
   for (LargePage* lop : *heap_->lo_space()) {
     SetOldSpacePageFlags(lop, false, false);
   }
+
+  for (LargePage* lop : *heap_->new_lo_space()) {
+    SetNewSpacePageFlags(lop, false);
+  }
 }
 
 
@@ -389,6 +395,10 @@ void IncrementalMarking::ActivateIncrementalWriteBarrier() {
   for (LargePage* lop : *heap_->lo_space()) {
     SetOldSpacePageFlags(lop, true, is_compacting_);
   }
+
+  for (LargePage* lop : *heap_->new_lo_space()) {
+    SetNewSpacePageFlags(lop, true);
+  }
 }
 
 
@@ -789,6 +799,28 @@ void IncrementalMarking::UpdateMarkingWorklistAfterScavenge() {
       return false;
     }
   });
+
+  // Ephemerons only speed up the marking of weak collections, the atomic
+  // pause scans their tables again. Entries of tables that did not move to a
+  // known location are dropped.
+  heap_->mark_compact_collector()->weak_objects()->ephemerons.Update(
+      [this](Ephemeron ephemeron, Ephemeron* out) -> bool {
+        HeapObject* table = ephemeron.table;
+        if (heap_->InFromSpace(table)) {
+          MapWord map_word = table->map_word();
+          if (!map_word.IsForwardingAddress()) return false;
+          out->table = ObjectHashTable::cast(map_word.ToForwardingAddress());
+          out->entry = ephemeron.entry;
+          return true;
+        }
+        if (heap_->InToSpace(table) ||
+            Page::FromAddress(table->address())
+                ->IsFlagSet(Page::SWEEP_TO_ITERATE)) {
+          return false;
+        }
+        *out = ephemeron;
+        return true;
+      });
 }
 
 bool IncrementalMarking::IsFixedArrayWithProgressBar(HeapObject* obj) {
@@ -825,7 +857,9 @@ void IncrementalMarking::RevisitObject(HeapObject* obj) {
   DCHECK(IsMarking());
   DCHECK(FLAG_concurrent_marking || marking_state()->IsBlack(obj));
   Page* page = Page::FromAddress(obj->address());
-  if ((page->owner() != nullptr) && (page->owner()->identity() == LO_SPACE)) {
+  if ((page->owner() != nullptr) &&
+      (page->owner()->identity() == LO_SPACE ||
+       page->owner()->identity() == NEW_LO_SPACE)) {
     page->ResetProgressBar();
   }
   Map* map = obj->map();
@@ -1087,9 +1121,14 @@ void IncrementalMarking::AdvanceIncrementalMarkingOnAllocation() {
   if (bytes_to_process >= IncrementalMarking::kAllocatedThreshold) {
     // The first step after Scavenge will see many allocated bytes.
     // Cap the step size to distribute the marking work more uniformly.
-    size_t max_step_size = GCIdleTimeHandler::EstimateMarkingStepSize(
-        kMaxStepSizeInMs,
-        heap()->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond());
+    const double marking_speed =
+        heap()->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond();
+    GCLatencyScheduler* scheduler = heap()->gc_latency_scheduler();
+    size_t max_step_size =
+        scheduler->enabled()
+            ? scheduler->MaxMarkingStepSize(marking_speed)
+            : GCIdleTimeHandler::EstimateMarkingStepSize(kMaxStepSizeInMs,
+                                                         marking_speed);
     bytes_to_process = Min(bytes_to_process, max_step_size);
 
     size_t bytes_processed = 0;
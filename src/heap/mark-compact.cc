@@ -16,6 +16,7 @@
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-statistics-recorder.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/invalidated-slots-inl.h"
 #include "src/heap/item-parallel-job.h"
@@ -432,6 +433,18 @@ int MarkCompactCollectorBase::NumberOfParallelToSpacePointerUpdateTasks(
                                       : 1;
 }
 
+int MarkCompactCollector::NumberOfParallelMapClearingTasks(
+    int transition_arrays) {
+  // Compacting a transition array is cheap, so a task only pays off for a
+  // large number of arrays.
+  const int kTransitionArraysPerTask = 512;
+  const int wanted_tasks = Max(1, transition_arrays / kTransitionArraysPerTask);
+  return FLAG_parallel_map_clearing
+             ? Min(NumberOfAvailableCores(),
+                   Min(wanted_tasks, ConcurrentMarking::kTasks + 1))
+             : 1;
+}
+
 int MinorMarkCompactCollector::NumberOfParallelMarkingTasks(int pages) {
   DCHECK_GT(pages, 0);
   if (!FLAG_minor_mc_parallel_marking) return 1;
@@ -454,6 +467,9 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       black_allocation_(false),
       have_code_to_deoptimize_(false),
       marking_worklist_(heap),
+      last_scanned_weak_collection_(Smi::kZero),
+      string_deduplication_gc_count_(0),
+      string_deduplication_resume_address_(nullptr),
       sweeper_(heap, non_atomic_marking_state()) {
   old_to_new_slots_ = -1;
 }
@@ -528,6 +544,13 @@ void MarkCompactCollector::CollectGarbage() {
 
   RecordObjectStats();
 
+  if (FLAG_string_deduplication) CollectStringDeduplicationCandidates();
+
+  if (heap()->heap_statistics_recorder()->enabled()) {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_HEAP_STATISTICS);
+    heap()->heap_statistics_recorder()->CollectLiveObjectStatistics();
+  }
+
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
     FullMarkingVerifier verifier(heap());
@@ -605,6 +628,7 @@ void MarkCompactCollector::ClearMarkbits() {
   ClearMarkbitsInPagedSpace(heap_->old_space());
   ClearMarkbitsInNewSpace(heap_->new_space());
   heap_->lo_space()->ClearMarkingStateOfLiveObjects();
+  heap_->new_lo_space()->ClearMarkingStateOfLiveObjects();
 }
 
 class MarkCompactCollector::Sweeper::SweeperTask final : public CancelableTask {
@@ -658,21 +682,40 @@ void MarkCompactCollector::Sweeper::StartSweeping() {
   });
 }
 
+int MarkCompactCollector::Sweeper::NumberOfConcurrentSweepers() {
+  size_t pages = 0;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    for (int i = FIRST_PAGED_SPACE; i <= LAST_PAGED_SPACE; i++) {
+      pages += sweeping_list_[i].size();
+    }
+  }
+  const int wanted_tasks = static_cast<int>(
+      (pages + kPagesPerSweeperTask - 1) / kPagesPerSweeperTask);
+  return Max(1, Min(Min(wanted_tasks, kMaxSweeperTasks),
+                    NumberOfAvailableCores()));
+}
+
 void MarkCompactCollector::Sweeper::StartSweeperTasks() {
   DCHECK_EQ(0, num_tasks_);
   DCHECK_EQ(0, num_sweeping_tasks_.Value());
   if (FLAG_concurrent_sweeping && sweeping_in_progress_) {
-    ForAllSweepingSpaces([this](AllocationSpace space) {
-      if (space == NEW_SPACE) return;
+    const int num_tasks = NumberOfConcurrentSweepers();
+    const int num_paged_spaces = LAST_PAGED_SPACE - FIRST_PAGED_SPACE + 1;
+    for (int i = 0; i < num_tasks; i++) {
+      // Spread the starting spaces so that code and map space pages are not
+      // left to the main thread while all tasks work on old space.
+      const AllocationSpace space_to_start = static_cast<AllocationSpace>(
+          FIRST_PAGED_SPACE + i % num_paged_spaces);
       num_sweeping_tasks_.Increment(1);
       SweeperTask* task = new SweeperTask(heap_->isolate(), this,
                                           &pending_sweeper_tasks_semaphore_,
-                                          &num_sweeping_tasks_, space);
+                                          &num_sweeping_tasks_, space_to_start);
       DCHECK_LT(num_tasks_, kMaxSweeperTasks);
       task_ids_[num_tasks_++] = task->id();
       V8::GetCurrentPlatform()->CallOnBackgroundThread(
           task, v8::Platform::kShortRunningTask);
-    });
+    }
   }
 }
 
@@ -813,6 +856,22 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
     }
     *max_evacuated_bytes = kMaxEvacuatedBytes;
   }
+
+  // An explicit time budget bounds the amount of evacuated memory in all
+  // modes. Candidates are selected from the least to the most live page, so
+  // pages that do not fit into the budget of this GC are picked up by
+  // subsequent GCs. The budget never drops below a single area so that the
+  // sparsest pages can still be merged, i.e., every GC makes some progress.
+  if (FLAG_compaction_time_budget > 0) {
+    const double estimated_compaction_speed =
+        heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
+    if (estimated_compaction_speed != 0) {
+      const size_t budget_bytes = Max(
+          area_size, static_cast<size_t>(FLAG_compaction_time_budget *
+                                         estimated_compaction_speed));
+      *max_evacuated_bytes = Min(*max_evacuated_bytes, budget_bytes);
+    }
+  }
 }
 
 
@@ -2560,6 +2619,11 @@ void MarkCompactCollector::MarkLiveObjects() {
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_WEAK_CLOSURE);
 
+    // The ephemerons left by concurrent marking may refer to tables that were
+    // replaced since. The tables of all encountered weak collections are
+    // scanned again below, so only their values marked so far are reused.
+    weak_objects_.ephemerons.Clear();
+
     // The objects reachable from the roots are marked, yet unreachable
     // objects are unmarked.  Mark objects reachable due to host
     // application specific logic or through Harmony weak maps.
@@ -2609,6 +2673,151 @@ void MarkCompactCollector::MarkLiveObjects() {
 }
 
 
+void MarkCompactCollector::CollectStringDeduplicationCandidates() {
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_STRING_DEDUPLICATION);
+  string_deduplication_candidates_.clear();
+  string_deduplication_gc_count_ = heap()->gc_count();
+  const size_t max_candidates =
+      static_cast<size_t>(Max(0, FLAG_string_deduplication_max_candidates));
+  std::vector<Page*> pages;
+  for (Page* p : *heap()->old_space()) pages.push_back(p);
+  // Resume after the last candidate of the previous GC, so that all of old
+  // space is considered over a series of GCs when there are more candidates
+  // than fit into one. The start page is visited again at the end for the
+  // objects before that position.
+  Address resume = string_deduplication_resume_address_;
+  string_deduplication_resume_address_ = nullptr;
+  size_t start = 0;
+  if (resume != nullptr) {
+    Page* resume_page = Page::FromAddress(resume);
+    auto it = std::find(pages.begin(), pages.end(), resume_page);
+    if (it == pages.end()) {
+      resume = nullptr;
+    } else {
+      start = it - pages.begin();
+    }
+  }
+  const size_t steps = pages.size() + (resume != nullptr ? 1 : 0);
+  for (size_t i = 0; i < steps; i++) {
+    Page* p = pages[(start + i) % pages.size()];
+    // Only pages that are not evacuated keep their objects in place, so that
+    // the candidates remain valid after this GC.
+    if (p->IsEvacuationCandidate()) continue;
+    for (auto object_and_size : LiveObjectRange<kBlackObjects>(
+             p, non_atomic_marking_state()->bitmap(p))) {
+      HeapObject* const object = object_and_size.first;
+      if (resume != nullptr) {
+        if (i == 0 && object->address() <= resume) continue;
+        if (i == steps - 1 && object->address() > resume) break;
+      }
+      if (!object->IsSeqString() || object->IsInternalizedString()) continue;
+      String* string = String::cast(object);
+      if (string->length() < FLAG_string_deduplication_min_length) continue;
+      if (string_deduplication_candidates_.size() >= max_candidates) {
+        string_deduplication_resume_address_ =
+            string_deduplication_candidates_.empty()
+                ? nullptr
+                : string_deduplication_candidates_.back()->address();
+        return;
+      }
+      string_deduplication_candidates_.push_back(string);
+    }
+  }
+}
+
+void MarkCompactCollector::DeduplicateStrings() {
+  if (string_deduplication_candidates_.empty()) return;
+  std::vector<String*> candidates;
+  candidates.swap(string_deduplication_candidates_);
+  // Another GC may have moved or freed the candidates in the meantime.
+  if (string_deduplication_gc_count_ != heap()->gc_count()) return;
+  DisallowHeapAllocation no_gc;
+  HandleScope scope(isolate());
+
+  // Equal strings have equal hashes and lengths, so sorting by both puts
+  // every group of equal candidates into one run. Array indices are never
+  // made thin, see StringTable::LookupStringIfExists_NoAllocate.
+  const size_t candidate_count = candidates.size();
+  candidates.erase(
+      std::remove_if(candidates.begin(), candidates.end(),
+                     [](String* string) {
+                       string->Hash();
+                       return (string->hash_field() &
+                               Name::kIsNotArrayIndexMask) == 0;
+                     }),
+      candidates.end());
+  std::sort(candidates.begin(), candidates.end(), [](String* a, String* b) {
+    if (a->hash_field() != b->hash_field()) {
+      return a->hash_field() < b->hash_field();
+    }
+    return a->length() < b->length();
+  });
+
+  size_t deduplicated = 0;
+  std::vector<String*> group;
+  for (size_t run_start = 0; run_start < candidates.size();) {
+    size_t run_end = run_start + 1;
+    while (run_end < candidates.size() &&
+           candidates[run_end]->hash_field() ==
+               candidates[run_start]->hash_field() &&
+           candidates[run_end]->length() == candidates[run_start]->length()) {
+      run_end++;
+    }
+    // A run may still hold strings that only collide in their hash. Split it
+    // into groups of equal strings.
+    for (size_t i = run_start; i < run_end; i++) {
+      if (candidates[i] == nullptr) continue;
+      group.clear();
+      group.push_back(candidates[i]);
+      for (size_t j = i + 1; j < run_end; j++) {
+        if (candidates[j] != nullptr &&
+            candidates[i]->Equals(candidates[j])) {
+          group.push_back(candidates[j]);
+          candidates[j] = nullptr;
+        }
+      }
+      deduplicated += DeduplicateStringGroup(group);
+    }
+    run_start = run_end;
+  }
+  if (FLAG_trace_gc_verbose) {
+    isolate()->PrintWithTimestamp(
+        "String deduplication: %" PRIuS " of %" PRIuS " candidates\n",
+        deduplicated, candidate_count);
+  }
+}
+
+size_t MarkCompactCollector::DeduplicateStringGroup(
+    const std::vector<String*>& group) {
+  if (group.size() < 2) {
+    // A single copy is only replaced by an existing internalized string.
+    return StringTable::LookupStringIfExists_NoAllocate(group[0])->IsString()
+               ? 1
+               : 0;
+  }
+  // All members forward to one internalized copy. If there is none yet, the
+  // first member is internalized in place; candidates are old space
+  // sequential strings, so this only writes its map. The string table is
+  // never grown here, which would allocate.
+  size_t deduplicated = 0;
+  String* representative = group[0];
+  if (StringTable::LookupStringIfExists_NoAllocate(representative)
+          ->IsString()) {
+    deduplicated++;
+  } else if (heap()->string_table()->HasSufficientCapacityToAdd(1)) {
+    StringTable::LookupString(isolate(), handle(representative, isolate()));
+    DCHECK(representative->IsInternalizedString());
+  } else {
+    return 0;
+  }
+  for (size_t i = 1; i < group.size(); i++) {
+    if (StringTable::LookupStringIfExists_NoAllocate(group[i])->IsString()) {
+      deduplicated++;
+    }
+  }
+  return deduplicated;
+}
+
 void MarkCompactCollector::ClearNonLiveReferences() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR);
 
@@ -2618,6 +2827,9 @@ void MarkCompactCollector::ClearNonLiveReferences() {
     // Prune the string table removing all strings only pointed to by the
     // string table.  Cannot use string_table() here because the string
     // table is marked.
+    // Background threads may be probing the table, see
+    // StringTable::ConcurrentFindEntry.
+    base::LockGuard<base::Mutex> guard(heap()->relocation_mutex());
     StringTable* string_table = heap()->string_table();
     InternalizedStringTableCleaner internalized_visitor(heap(), string_table);
     string_table->IterateElements(&internalized_visitor);
@@ -2649,6 +2861,7 @@ void MarkCompactCollector::ClearNonLiveReferences() {
 
   DCHECK(weak_objects_.weak_cells.IsGlobalEmpty());
   DCHECK(weak_objects_.transition_arrays.IsGlobalEmpty());
+  DCHECK(weak_objects_.ephemerons.IsGlobalEmpty());
 }
 
 
@@ -2744,28 +2957,108 @@ void MarkCompactCollector::ClearSimpleMapTransition(Map* map,
   }
 }
 
+class MapClearingTask final : public ItemParallelJob::Task {
+ public:
+  MapClearingTask(
+      Isolate* isolate, MarkCompactCollector* collector, int task_id,
+      std::vector<MarkCompactCollector::CompactedTransitionArray>* compacted)
+      : ItemParallelJob::Task(isolate),
+        collector_(collector),
+        task_id_(task_id),
+        compacted_(compacted) {}
+
+  void RunInParallel() final {
+    collector_->CompactTransitionArrays(task_id_, compacted_);
+  }
+
+ private:
+  MarkCompactCollector* const collector_;
+  const int task_id_;
+  std::vector<MarkCompactCollector::CompactedTransitionArray>* const
+      compacted_;
+};
+
 void MarkCompactCollector::ClearFullMapTransitions() {
+  // Share the arrays found by the main thread with the other tasks. The
+  // concurrent marking tasks have already published theirs.
+  weak_objects_.transition_arrays.FlushToGlobal(kMainThread);
+  int transition_arrays = 0;
+  weak_objects_.transition_arrays.IterateGlobalPool(
+      [&transition_arrays](TransitionArray* array) { transition_arrays++; });
+
+  const int num_tasks = NumberOfParallelMapClearingTasks(transition_arrays);
+  std::vector<CompactedTransitionArray> compacted[ConcurrentMarking::kTasks +
+                                                  1];
+  ItemParallelJob job(isolate()->cancelable_task_manager(),
+                      &page_parallel_job_semaphore_);
+  for (int i = 0; i < num_tasks; i++) {
+    job.AddTask(new MapClearingTask(isolate(), this, i, &compacted[i]));
+  }
+  job.Run();
+  DCHECK(weak_objects_.transition_arrays.IsGlobalEmpty());
+
+  // Trimming creates fillers, which updates the store buffer and the heap
+  // profiler, so it stays on the main thread.
+  for (int i = 0; i < num_tasks; i++) {
+    for (const CompactedTransitionArray& entry : compacted[i]) {
+      TrimCompactedTransitionArray(entry);
+    }
+  }
+}
+
+void MarkCompactCollector::CompactTransitionArrays(
+    int task_id, std::vector<CompactedTransitionArray>* compacted) {
   TransitionArray* array;
-  while (weak_objects_.transition_arrays.Pop(kMainThread, &array)) {
+  while (weak_objects_.transition_arrays.Pop(task_id, &array)) {
     int num_transitions = array->number_of_entries();
-    if (num_transitions > 0) {
-      Map* map = array->GetTarget(0);
-      DCHECK_NOT_NULL(map);  // WeakCells aren't cleared yet.
-      Map* parent = Map::cast(map->constructor_or_backpointer());
-      bool parent_is_alive = non_atomic_marking_state()->IsBlackOrGrey(parent);
-      DescriptorArray* descriptors =
-          parent_is_alive ? parent->instance_descriptors() : nullptr;
-      bool descriptors_owner_died =
-          CompactTransitionArray(parent, array, descriptors);
-      if (descriptors_owner_died) {
-        TrimDescriptorArray(parent, descriptors);
-      }
+    if (num_transitions == 0) continue;
+    Map* map = array->GetTarget(0);
+    DCHECK_NOT_NULL(map);  // WeakCells aren't cleared yet.
+    Map* parent = Map::cast(map->constructor_or_backpointer());
+    bool parent_is_alive = non_atomic_marking_state()->IsBlackOrGrey(parent);
+    DescriptorArray* descriptors =
+        parent_is_alive ? parent->instance_descriptors() : nullptr;
+    int live_transitions = 0;
+    bool descriptors_owner_died = MoveLiveTransitionsToLeft(
+        parent, array, descriptors, &live_transitions);
+    // If there are no transitions to be cleared, the array stays as it is.
+    if (live_transitions == num_transitions) {
+      DCHECK(!descriptors_owner_died);
+      continue;
+    }
+    // A descriptor array is owned by a single map, so only the task that
+    // processes the transitions of its parent can touch it.
+    bool trim_descriptors = false;
+    if (descriptors_owner_died && parent->NumberOfOwnDescriptors() > 0) {
+      trim_descriptors = SortOwnDescriptors(parent, descriptors);
     }
+    compacted->push_back({array, live_transitions,
+                          descriptors_owner_died ? parent : nullptr,
+                          trim_descriptors});
   }
 }
 
-bool MarkCompactCollector::CompactTransitionArray(
-    Map* map, TransitionArray* transitions, DescriptorArray* descriptors) {
+void MarkCompactCollector::TrimCompactedTransitionArray(
+    const CompactedTransitionArray& compacted) {
+  TrimTransitionArray(compacted.transitions, compacted.live_transitions);
+  Map* map = compacted.descriptors_owner;
+  if (map == nullptr) return;
+  if (map->NumberOfOwnDescriptors() == 0) {
+    DCHECK(map->instance_descriptors() == heap_->empty_descriptor_array());
+    return;
+  }
+  DescriptorArray* descriptors = map->instance_descriptors();
+  if (compacted.trim_descriptors) {
+    TrimDescriptorArrayStorage(map, descriptors);
+  }
+  DCHECK(descriptors->number_of_descriptors() ==
+         map->NumberOfOwnDescriptors());
+  map->set_owns_descriptors(true);
+}
+
+bool MarkCompactCollector::MoveLiveTransitionsToLeft(
+    Map* map, TransitionArray* transitions, DescriptorArray* descriptors,
+    int* live_transitions) {
   DCHECK(!map->is_prototype_map());
   int num_transitions = transitions->number_of_entries();
   bool descriptors_owner_died = false;
@@ -2794,22 +3087,22 @@ bool MarkCompactCollector::CompactTransitionArray(
       transition_index++;
     }
   }
-  // If there are no transitions to be cleared, return.
-  if (transition_index == num_transitions) {
-    DCHECK(!descriptors_owner_died);
-    return false;
-  }
+  *live_transitions = transition_index;
+  return descriptors_owner_died;
+}
+
+void MarkCompactCollector::TrimTransitionArray(TransitionArray* transitions,
+                                               int live_transitions) {
   // Note that we never eliminate a transition array, though we might right-trim
   // such that number_of_transitions() == 0. If this assumption changes,
   // TransitionArray::Insert() will need to deal with the case that a transition
   // array disappeared during GC.
-  int trim = transitions->Capacity() - transition_index;
+  int trim = transitions->Capacity() - live_transitions;
   if (trim > 0) {
     heap_->RightTrimFixedArray(transitions,
                                trim * TransitionArray::kTransitionSize);
-    transitions->SetNumberOfTransitions(transition_index);
+    transitions->SetNumberOfTransitions(live_transitions);
   }
-  return descriptors_owner_died;
 }
 
 
@@ -2821,25 +3114,42 @@ void MarkCompactCollector::TrimDescriptorArray(Map* map,
     return;
   }
 
+  if (SortOwnDescriptors(map, descriptors)) {
+    TrimDescriptorArrayStorage(map, descriptors);
+  }
+  DCHECK(descriptors->number_of_descriptors() == number_of_own_descriptors);
+  map->set_owns_descriptors(true);
+}
+
+bool MarkCompactCollector::SortOwnDescriptors(Map* map,
+                                              DescriptorArray* descriptors) {
+  int number_of_own_descriptors = map->NumberOfOwnDescriptors();
+  DCHECK_GT(number_of_own_descriptors, 0);
   int number_of_descriptors = descriptors->number_of_descriptors_storage();
-  int to_trim = number_of_descriptors - number_of_own_descriptors;
-  if (to_trim > 0) {
-    heap_->RightTrimFixedArray(descriptors,
-                               to_trim * DescriptorArray::kEntrySize);
-    descriptors->SetNumberOfDescriptors(number_of_own_descriptors);
+  if (number_of_descriptors == number_of_own_descriptors) return false;
+  DCHECK_GT(number_of_descriptors, number_of_own_descriptors);
+  descriptors->SetNumberOfDescriptors(number_of_own_descriptors);
+  descriptors->Sort();
+  return true;
+}
 
-    TrimEnumCache(map, descriptors);
-    descriptors->Sort();
+void MarkCompactCollector::TrimDescriptorArrayStorage(
+    Map* map, DescriptorArray* descriptors) {
+  int number_of_own_descriptors = map->NumberOfOwnDescriptors();
+  int to_trim =
+      descriptors->number_of_descriptors_storage() - number_of_own_descriptors;
+  DCHECK_GT(to_trim, 0);
+  heap_->RightTrimFixedArray(descriptors,
+                             to_trim * DescriptorArray::kEntrySize);
 
-    if (FLAG_unbox_double_fields) {
-      LayoutDescriptor* layout_descriptor = map->layout_descriptor();
-      layout_descriptor = layout_descriptor->Trim(heap_, map, descriptors,
-                                                  number_of_own_descriptors);
-      SLOW_DCHECK(layout_descriptor->IsConsistentWithMap(map, true));
-    }
+  TrimEnumCache(map, descriptors);
+
+  if (FLAG_unbox_double_fields) {
+    LayoutDescriptor* layout_descriptor = map->layout_descriptor();
+    layout_descriptor = layout_descriptor->Trim(heap_, map, descriptors,
+                                                number_of_own_descriptors);
+    SLOW_DCHECK(layout_descriptor->IsConsistentWithMap(map, true));
   }
-  DCHECK(descriptors->number_of_descriptors() == number_of_own_descriptors);
-  map->set_owns_descriptors(true);
 }
 
 
@@ -2865,28 +3175,53 @@ void MarkCompactCollector::TrimEnumCache(Map* map,
 
 
 void MarkCompactCollector::ProcessWeakCollections() {
-  MarkCompactMarkingVisitor visitor(this);
+  // Weak collections are prepended to the list when they are marked, so the
+  // collections behind the last scanned head have been scanned already.
   Object* weak_collection_obj = heap()->encountered_weak_collections();
-  while (weak_collection_obj != Smi::kZero) {
+  while (weak_collection_obj != last_scanned_weak_collection_) {
     JSWeakCollection* weak_collection =
         reinterpret_cast<JSWeakCollection*>(weak_collection_obj);
     DCHECK(non_atomic_marking_state()->IsBlackOrGrey(weak_collection));
     if (weak_collection->table()->IsHashTable()) {
       ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
       for (int i = 0; i < table->Capacity(); i++) {
-        HeapObject* heap_object = HeapObject::cast(table->KeyAt(i));
-        if (non_atomic_marking_state()->IsBlackOrGrey(heap_object)) {
-          Object** key_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(i));
-          RecordSlot(table, key_slot, *key_slot);
-          Object** value_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(i));
-          visitor.MarkObjectByPointer(table, value_slot);
+        Ephemeron ephemeron = {table, i};
+        if (!ProcessEphemeron(ephemeron)) {
+          weak_objects_.ephemerons.Push(kMainThread, ephemeron);
         }
       }
     }
     weak_collection_obj = weak_collection->next();
   }
+  last_scanned_weak_collection_ = heap()->encountered_weak_collections();
+
+  // Retry the ephemerons whose keys were unreachable so far. Only this
+  // shrinking set is iterated until the marking fixpoint is reached.
+  std::vector<Ephemeron> pending;
+  Ephemeron ephemeron;
+  while (weak_objects_.ephemerons.Pop(kMainThread, &ephemeron)) {
+    if (!ProcessEphemeron(ephemeron)) pending.push_back(ephemeron);
+  }
+  for (const Ephemeron& ephemeron : pending) {
+    weak_objects_.ephemerons.Push(kMainThread, ephemeron);
+  }
+}
+
+bool MarkCompactCollector::ProcessEphemeron(const Ephemeron& ephemeron) {
+  ObjectHashTable* table = ephemeron.table;
+  HeapObject* key = HeapObject::cast(table->KeyAt(ephemeron.entry));
+  if (!non_atomic_marking_state()->IsBlackOrGrey(key)) return false;
+  Object** key_slot = table->RawFieldOfElementAt(
+      ObjectHashTable::EntryToIndex(ephemeron.entry));
+  RecordSlot(table, key_slot, key);
+  Object** value_slot = table->RawFieldOfElementAt(
+      ObjectHashTable::EntryToValueIndex(ephemeron.entry));
+  if ((*value_slot)->IsHeapObject()) {
+    HeapObject* value = HeapObject::cast(*value_slot);
+    RecordSlot(table, value_slot, value);
+    MarkObject(table, value);
+  }
+  return true;
 }
 
 
@@ -2910,6 +3245,9 @@ void MarkCompactCollector::ClearWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::kZero);
+  last_scanned_weak_collection_ = Smi::kZero;
+  // The remaining ephemerons have unreachable keys.
+  weak_objects_.ephemerons.Clear();
 }
 
 
@@ -2922,6 +3260,7 @@ void MarkCompactCollector::AbortWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::kZero);
+  last_scanned_weak_collection_ = Smi::kZero;
 }
 
 void MarkCompactCollector::ClearWeakCellsAndSimpleMapTransitions(
@@ -2985,6 +3324,7 @@ void MarkCompactCollector::ClearWeakCellsAndSimpleMapTransitions(
 void MarkCompactCollector::AbortWeakObjects() {
   weak_objects_.weak_cells.Clear();
   weak_objects_.transition_arrays.Clear();
+  weak_objects_.ephemerons.Clear();
 }
 
 void MarkCompactCollector::RecordRelocSlot(Code* host, RelocInfo* rinfo,
@@ -3449,12 +3789,16 @@ void MarkCompactCollectorBase::CreateAndExecuteEvacuationTasks(
   }
 }
 
-bool MarkCompactCollectorBase::ShouldMovePage(Page* p, intptr_t live_bytes) {
+bool MarkCompactCollectorBase::CanMovePage(Page* p, intptr_t live_bytes) {
   const bool reduce_memory = heap()->ShouldReduceMemory();
   const Address age_mark = heap()->new_space()->age_mark();
-  return !reduce_memory && !p->NeverEvacuate() &&
-         (live_bytes > Evacuator::PageEvacuationThreshold()) &&
-         !p->Contains(age_mark) && heap()->CanExpandOldGeneration(live_bytes);
+  return !reduce_memory && !p->NeverEvacuate() && !p->Contains(age_mark) &&
+         heap()->CanExpandOldGeneration(live_bytes);
+}
+
+bool MarkCompactCollectorBase::ShouldMovePage(Page* p, intptr_t live_bytes) {
+  return (live_bytes > Evacuator::PageEvacuationThreshold()) &&
+         CanMovePage(p, live_bytes);
 }
 
 void MarkCompactCollector::EvacuatePagesInParallel() {
@@ -3502,7 +3846,13 @@ void MinorMarkCompactCollector::EvacuatePagesInParallel() {
     intptr_t live_bytes_on_page = non_atomic_marking_state()->live_bytes(page);
     if (live_bytes_on_page == 0 && !page->contains_array_buffers()) continue;
     live_bytes += live_bytes_on_page;
-    if (ShouldMovePage(page, live_bytes_on_page)) {
+    // With --minor-mc-promote-in-place survivors are never copied. Pages are
+    // moved regardless of their utilization and the dead objects on them are
+    // turned into free space by the sweeper.
+    const bool move_page = FLAG_minor_mc_promote_in_place
+                               ? CanMovePage(page, live_bytes_on_page)
+                               : ShouldMovePage(page, live_bytes_on_page);
+    if (move_page) {
       if (page->IsFlagSet(MemoryChunk::NEW_SPACE_BELOW_AGE_MARK)) {
         EvacuateNewSpacePageVisitor<NEW_TO_OLD>::Move(page);
       } else {
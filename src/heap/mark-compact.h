@@ -287,7 +287,11 @@ class MarkCompactCollectorBase {
       RecordMigratedSlotVisitor* record_visitor,
       MigrationObserver* migration_observer, const intptr_t live_bytes);
 
-  // Returns whether this page should be moved according to heuristics.
+  // Returns whether the page can be moved as a whole, i.e., whether its live
+  // objects can be kept in place when evacuating.
+  bool CanMovePage(Page* p, intptr_t live_bytes);
+  // Returns whether the page can be moved and is dense enough that moving is
+  // preferable over copying its live objects.
   bool ShouldMovePage(Page* p, intptr_t live_bytes);
 
   int CollectToSpaceUpdatingItems(ItemParallelJob* job);
@@ -467,10 +471,19 @@ class MajorNonAtomicMarkingState final
   }
 };
 
+// An entry of the backing table of a weak collection. The value of the entry
+// is live only if the key is live.
+struct Ephemeron {
+  ObjectHashTable* table;
+  int entry;
+};
+
 // Weak objects encountered during marking.
 struct WeakObjects {
   Worklist<WeakCell*, 64> weak_cells;
   Worklist<TransitionArray*, 64> transition_arrays;
+  // Ephemerons with keys that were not marked when their table was visited.
+  Worklist<Ephemeron, 64> ephemerons;
 };
 
 // Collector for young and old generation.
@@ -479,6 +492,18 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   using NonAtomicMarkingState = MajorNonAtomicMarkingState;
 
   static const int kMainThread = 0;
+
+  // A transition array whose live transitions were moved to the left by a
+  // map clearing task.
+  struct CompactedTransitionArray {
+    TransitionArray* transitions;
+    int live_transitions;
+    // The parent map if the owner of its descriptors died, nullptr otherwise.
+    Map* descriptors_owner;
+    // True if the descriptor array of |descriptors_owner| has to be trimmed.
+    bool trim_descriptors;
+  };
+
   // Wrapper for the shared and bailout worklists.
   class MarkingWorklist {
    public:
@@ -625,7 +650,12 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
     class SweeperTask;
 
     static const int kAllocationSpaces = LAST_PAGED_SPACE + 1;
-    static const int kMaxSweeperTasks = kAllocationSpaces;
+    // Sweeper tasks are not bound to a space. Pages are handed out one at a
+    // time from the per-space sweeping lists, so that idle tasks pick up work
+    // from the spaces other tasks are still busy with.
+    static const int kMaxSweeperTasks = 8;
+    // Minimum number of pages that justify spawning an additional task.
+    static const int kPagesPerSweeperTask = 4;
 
     template <typename Callback>
     void ForAllSweepingSpaces(Callback callback) {
@@ -636,6 +666,10 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
     Page* GetSweepingPageSafe(AllocationSpace space);
 
+    // Number of background tasks to start for the pages currently queued in
+    // the old generation sweeping lists.
+    int NumberOfConcurrentSweepers();
+
     void PrepareToBeSweptPage(AllocationSpace space, Page* page);
 
     Heap* const heap_;
@@ -678,6 +712,13 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   void AbortCompaction();
 
+  // Turns the string deduplication candidates found by the last full GC into
+  // ThinStrings. Equal candidates are grouped by hash and contents, and all
+  // members of a group forward to one internalized copy: an existing one, or
+  // the first member internalized in place. This does not allocate, so a
+  // group is left alone if the string table would have to grow.
+  void DeduplicateStrings();
+
   static inline bool IsOnEvacuationCandidate(HeapObject* obj) {
     return Page::FromAddress(reinterpret_cast<Address>(obj))
         ->IsEvacuationCandidate();
@@ -754,6 +795,15 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   void RecordObjectStats();
 
+  // Collects live non-internalized sequential strings in old space that stay
+  // in place during this GC as candidates for DeduplicateStrings(), up to
+  // --string-deduplication-max-candidates. Collection resumes where the
+  // previous GC stopped.
+  void CollectStringDeduplicationCandidates();
+  // Makes all strings of {group} forward to one internalized copy and returns
+  // the number of strings that became ThinStrings.
+  size_t DeduplicateStringGroup(const std::vector<String*>& group);
+
   // Finishes GC, performs heap verification if enabled.
   void Finish();
 
@@ -816,17 +866,41 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   void ClearSimpleMapTransition(Map* map, Map* dead_target);
   // Compact every array in the global list of transition arrays and
   // trim the corresponding descriptor array if a transition target is non-live.
+  // The arrays are compacted by parallel tasks, the trimming is done on the
+  // main thread afterwards.
   void ClearFullMapTransitions();
-  bool CompactTransitionArray(Map* map, TransitionArray* transitions,
-                              DescriptorArray* descriptors);
+  int NumberOfParallelMapClearingTasks(int transition_arrays);
+  // Called by the map clearing tasks. Pops transition arrays from the view
+  // |task_id| of the worklist until it is empty and records the arrays that
+  // need trimming in |compacted|.
+  void CompactTransitionArrays(
+      int task_id, std::vector<CompactedTransitionArray>* compacted);
+  void TrimCompactedTransitionArray(const CompactedTransitionArray& compacted);
+  // Moves the live transitions to the left without trimming the array.
+  // Returns true if the owner of |descriptors| died.
+  bool MoveLiveTransitionsToLeft(Map* map, TransitionArray* transitions,
+                                 DescriptorArray* descriptors,
+                                 int* live_transitions);
+  void TrimTransitionArray(TransitionArray* transitions, int live_transitions);
   void TrimDescriptorArray(Map* map, DescriptorArray* descriptors);
+  // Drops the descriptors that |map| does not own from the sorted key order.
+  // Only touches |descriptors|, so it can run on any thread. Returns true if
+  // the storage of the array has to be trimmed.
+  bool SortOwnDescriptors(Map* map, DescriptorArray* descriptors);
+  void TrimDescriptorArrayStorage(Map* map, DescriptorArray* descriptors);
   void TrimEnumCache(Map* map, DescriptorArray* descriptors);
 
   // Mark all values associated with reachable keys in weak collections
   // encountered so far.  This might push new object or even new weak maps onto
-  // the marking stack.
+  // the marking stack.  Only the tables of weak collections encountered since
+  // the last call are scanned; the entries with unreachable keys are kept on
+  // the ephemeron worklist and retried on the next call.
   void ProcessWeakCollections();
 
+  // Marks the value of the given ephemeron and records the slots of the entry
+  // if the key is reachable. Returns false if the key is not marked yet.
+  bool ProcessEphemeron(const Ephemeron& ephemeron);
+
   // After all reachable objects have been marked those weak map entries
   // with an unreachable key are removed from all encountered weak maps.
   // The linked list of all encountered weak maps is destroyed.
@@ -903,6 +977,10 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   MarkingWorklist marking_worklist_;
   WeakObjects weak_objects_;
 
+  // The head of the list of encountered weak collections at the end of the
+  // last ProcessWeakCollections call. Smi::kZero if no table was scanned yet.
+  Object* last_scanned_weak_collection_;
+
   // Candidates for pages that should be evacuated.
   std::vector<Page*> evacuation_candidates_;
   // Pages that are actually processed during evacuation.
@@ -910,6 +988,14 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   std::vector<Page*> new_space_evacuation_pages_;
   std::vector<std::pair<HeapObject*, Page*>> aborted_evacuation_candidates_;
 
+  // Strings found by CollectStringDeduplicationCandidates() and the GC count
+  // they are valid for.
+  std::vector<String*> string_deduplication_candidates_;
+  int string_deduplication_gc_count_;
+  // Address of the last candidate of a collection that hit the limit. The
+  // next collection starts after it.
+  Address string_deduplication_resume_address_;
+
   Sweeper sweeper_;
 
   NonAtomicMarkingState non_atomic_marking_state_;
@@ -917,6 +1003,7 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   friend class FullEvacuator;
   friend class Heap;
   friend class IncrementalMarkingMarkingVisitor;
+  friend class MapClearingTask;
   friend class MarkCompactMarkingVisitor;
   friend class RecordMigratedSlotVisitor;
 };
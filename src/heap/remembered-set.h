@@ -34,6 +34,22 @@ class RememberedSet : public AllStatic {
                                                            Page::kPageSize);
   }
 
+  // Given a page and the first slot of a slot set cell in that page, this
+  // function adds the slots selected by |mask| to the remembered set. Bit i
+  // of the mask selects the slot at cell_start + i * kPointerSize.
+  template <AccessMode access_mode = AccessMode::ATOMIC>
+  static void InsertCell(MemoryChunk* chunk, Address cell_start,
+                         uint32_t mask) {
+    DCHECK_LE(chunk->address(), cell_start);
+    SlotSet* slot_set = chunk->slot_set<type, access_mode>();
+    if (slot_set == nullptr) {
+      slot_set = chunk->AllocateSlotSet<type>();
+    }
+    uintptr_t offset = cell_start - chunk->address();
+    slot_set[offset / Page::kPageSize].InsertCell<access_mode>(
+        offset % Page::kPageSize, mask);
+  }
+
   // Given a page and a slot in that page, this function returns true if
   // the remembered set contains the slot.
   static bool Contains(MemoryChunk* chunk, Address slot_addr) {
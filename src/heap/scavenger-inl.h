@@ -117,7 +117,7 @@ bool Scavenger::PromoteObject(Map* map, HeapObject** slot, HeapObject* object,
     *slot = target;
 
     if (!ContainsOnlyData(static_cast<VisitorId>(map->visitor_id()))) {
-      promotion_list_.Push(ObjectAndSize(target, object_size));
+      promotion_list_.Push({target, map, object_size});
     }
     promoted_size_ += object_size;
     return true;
@@ -125,6 +125,29 @@ bool Scavenger::PromoteObject(Map* map, HeapObject** slot, HeapObject* object,
   return false;
 }
 
+bool Scavenger::HandleLargeObject(Map* map, HeapObject* object,
+                                  int object_size) {
+  if (V8_UNLIKELY(FLAG_young_generation_large_objects &&
+                  object_size > kMaxRegularHeapObjectSize)) {
+    DCHECK_EQ(NEW_LO_SPACE,
+              MemoryChunk::FromAddress(object->address())->owner()->identity());
+    // Forward the object to itself, so that other tasks and the weak
+    // processing see it as scavenged.
+    HeapObject* old = base::AsAtomicPointer::Release_CompareAndSwap(
+        reinterpret_cast<HeapObject**>(object->address()), map,
+        MapWord::FromForwardingAddress(object).ToMap());
+    if (old == map) {
+      surviving_new_large_objects_.push_back(std::make_pair(object, map));
+      if (!ContainsOnlyData(static_cast<VisitorId>(map->visitor_id()))) {
+        promotion_list_.Push({object, map, object_size});
+      }
+      promoted_size_ += object_size;
+    }
+    return true;
+  }
+  return false;
+}
+
 void Scavenger::EvacuateObjectDefault(Map* map, HeapObject** slot,
                                       HeapObject* object, int object_size) {
   SLOW_DCHECK(object_size <= Page::kAllocatableMemory);
@@ -204,6 +227,7 @@ void Scavenger::EvacuateObject(HeapObject** slot, Map* map,
   SLOW_DCHECK(heap_->InFromSpace(source));
   SLOW_DCHECK(!MapWord::FromMap(map).IsForwardingAddress());
   int size = source->SizeFromMap(map);
+  if (HandleLargeObject(map, source, size)) return;
   // Cannot use ::cast() below because that would add checks in debug mode
   // that require re-reading the map.
   switch (static_cast<VisitorId>(map->visitor_id())) {
@@ -36,11 +36,12 @@ class IterateAndScavengePromotedObjectsVisitor final : public ObjectVisitor {
           target = *slot;
           scavenger_->PageMemoryFence(target);
 
-          if (heap_->InNewSpace(target)) {
+          // Young large objects stay in from space until they are promoted
+          // after the scavenge, so only copied objects need a slot.
+          if (heap_->InToSpace(target)) {
             SLOW_DCHECK(target->IsHeapObject());
-            SLOW_DCHECK(heap_->InToSpace(target));
-            RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot_address),
-                                              slot_address);
+            RememberedSet<OLD_TO_NEW>::Insert(
+                MemoryChunk::FromAddress(host->address()), slot_address);
           }
           SLOW_DCHECK(!MarkCompactCollector::IsOnEvacuationCandidate(
               HeapObject::cast(target)));
@@ -72,7 +73,8 @@ Scavenger::Scavenger(Heap* heap, bool is_logging, CopiedList* copied_list,
       is_incremental_marking_(heap->incremental_marking()->IsMarking()),
       is_compacting_(heap->incremental_marking()->IsCompacting()) {}
 
-void Scavenger::IterateAndScavengePromotedObject(HeapObject* target, int size) {
+void Scavenger::IterateAndScavengePromotedObject(HeapObject* target, Map* map,
+                                                 int size) {
   // We are not collecting slots on new space objects during mutation
   // thus we have to scan for pointers to evacuation candidates when we
   // promote objects. But we should not record any slots in non-black
@@ -83,12 +85,14 @@ void Scavenger::IterateAndScavengePromotedObject(HeapObject* target, int size) {
       is_compacting_ &&
       heap()->incremental_marking()->atomic_marking_state()->IsBlack(target);
   IterateAndScavengePromotedObjectsVisitor visitor(heap(), this, record_slots);
-  if (target->IsJSFunction()) {
+  // The map word of |target| may be a forwarding pointer, so the map that was
+  // recorded at promotion time is used instead.
+  if (map->instance_type() == JS_FUNCTION_TYPE) {
     // JSFunctions reachable through kNextFunctionLinkOffset are weak. Slots for
     // this links are recorded during processing of weak lists.
     JSFunction::BodyDescriptorWeak::IterateBody(target, size, &visitor);
   } else {
-    target->IterateBody(target->map()->instance_type(), size, &visitor);
+    target->IterateBody(map->instance_type(), size, &visitor);
   }
 }
 
@@ -104,6 +108,7 @@ void Scavenger::Process(OneshotBarrier* barrier) {
   do {
     done = true;
     ObjectAndSize object_and_size;
+    PromotionListEntry entry;
     while ((promotion_list_.LocalPushSegmentSize() <
             kProcessPromotionListThreshold) &&
            copied_list_.Pop(&object_and_size)) {
@@ -116,11 +121,10 @@ void Scavenger::Process(OneshotBarrier* barrier) {
       }
     }
 
-    while (promotion_list_.Pop(&object_and_size)) {
-      HeapObject* target = object_and_size.first;
-      int size = object_and_size.second;
-      DCHECK(!target->IsMap());
-      IterateAndScavengePromotedObject(target, size);
+    while (promotion_list_.Pop(&entry)) {
+      DCHECK_NE(MAP_TYPE, entry.map->instance_type());
+      IterateAndScavengePromotedObject(entry.heap_object, entry.map,
+                                       entry.size);
       done = false;
       if (have_barrier && ((++objects % kInterruptThreshold) == 0)) {
         if (!promotion_list_.IsGlobalPoolEmpty()) {
@@ -149,6 +153,7 @@ void Scavenger::Finalize() {
   heap()->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
   heap()->IncrementSemiSpaceCopiedObjectSize(copied_size_);
   heap()->IncrementPromotedObjectsSize(promoted_size_);
+  heap()->MergeSurvivingNewLargeObjects(surviving_new_large_objects_);
   allocator_.Finalize();
 }
 
@@ -22,7 +22,16 @@ static const int kPromotionListSegmentSize = 256;
 using AddressRange = std::pair<Address, Address>;
 using ObjectAndSize = std::pair<HeapObject*, int>;
 using CopiedList = Worklist<ObjectAndSize, kCopiedListSegmentSize>;
-using PromotionList = Worklist<ObjectAndSize, kPromotionListSegmentSize>;
+
+// Promoted objects carry their map because young large objects are promoted
+// in place and have a forwarding pointer to themselves in the map word until
+// the end of the scavenge.
+struct PromotionListEntry {
+  HeapObject* heap_object;
+  Map* map;
+  int size;
+};
+using PromotionList = Worklist<PromotionListEntry, kPromotionListSegmentSize>;
 
 class Scavenger {
  public:
@@ -75,6 +84,12 @@ class Scavenger {
   V8_INLINE void EvacuateObject(HeapObject** slot, Map* map,
                                 HeapObject* source);
 
+  // Claims a young large object for this scavenger. The object stays where
+  // it is and its page is moved to the old generation by the heap after the
+  // scavenge.
+  V8_INLINE bool HandleLargeObject(Map* map, HeapObject* object,
+                                   int object_size);
+
   // Different cases for object evacuation.
 
   V8_INLINE void EvacuateObjectDefault(Map* map, HeapObject** slot,
@@ -89,7 +104,8 @@ class Scavenger {
   inline void EvacuateShortcutCandidate(Map* map, HeapObject** slot,
                                         ConsString* object, int object_size);
 
-  void IterateAndScavengePromotedObject(HeapObject* target, int size);
+  void IterateAndScavengePromotedObject(HeapObject* target, Map* map,
+                                        int size);
 
   void RecordCopiedObject(HeapObject* obj);
 
@@ -99,6 +115,7 @@ class Scavenger {
   PromotionList::View promotion_list_;
   CopiedList::View copied_list_;
   Heap::PretenuringFeedbackMap local_pretenuring_feedback_;
+  Heap::SurvivingNewLargeObjects surviving_new_large_objects_;
   size_t copied_size_;
   size_t promoted_size_;
   LocalAllocator allocator_;
@@ -34,6 +34,10 @@ class SlotSet : public Malloced {
     KEEP_EMPTY_BUCKETS      // An empty bucket will be kept.
   };
 
+  // Each cell of a bucket covers kBitsPerCell consecutive slots.
+  static const int kBitsPerCell = 32;
+  static const int kBitsPerCellLog2 = 5;
+
   SlotSet() {
     for (int i = 0; i < kBuckets; i++) {
       StoreBucket(&buckets_[i], nullptr);
@@ -59,22 +63,19 @@ class SlotSet : public Malloced {
   void Insert(int slot_offset) {
     int bucket_index, cell_index, bit_index;
     SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    Bucket bucket = LoadBucket<access_mode>(&buckets_[bucket_index]);
-    if (bucket == nullptr) {
-      bucket = AllocateBucket();
-      if (!SwapInNewBucket<access_mode>(&buckets_[bucket_index], bucket)) {
-        DeleteArray<uint32_t>(bucket);
-        bucket = LoadBucket<access_mode>(&buckets_[bucket_index]);
-      }
-    }
-    // Check that monotonicity is preserved, i.e., once a bucket is set we do
-    // not free it concurrently.
-    DCHECK_NOT_NULL(bucket);
-    DCHECK_EQ(bucket, LoadBucket<access_mode>(&buckets_[bucket_index]));
-    uint32_t mask = 1u << bit_index;
-    if ((LoadCell<access_mode>(&bucket[cell_index]) & mask) == 0) {
-      SetCellBits<access_mode>(&bucket[cell_index], mask);
-    }
+    InsertMask<access_mode>(bucket_index, cell_index, 1u << bit_index);
+  }
+
+  // The slot offset specifies the first slot of a cell. Bit i of the mask
+  // specifies the slot at address page_start_ + slot_offset + i * kPointerSize.
+  // All slots in the mask are added with a single update of the cell.
+  // The same threading restrictions as for Insert apply.
+  template <AccessMode access_mode = AccessMode::ATOMIC>
+  void InsertCell(int slot_offset, uint32_t mask) {
+    int bucket_index, cell_index, bit_index;
+    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
+    DCHECK_EQ(0, bit_index);
+    InsertMask<access_mode>(bucket_index, cell_index, mask);
   }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
@@ -267,12 +268,29 @@ class SlotSet : public Malloced {
   static const int kMaxSlots = (1 << kPageSizeBits) / kPointerSize;
   static const int kCellsPerBucket = 32;
   static const int kCellsPerBucketLog2 = 5;
-  static const int kBitsPerCell = 32;
-  static const int kBitsPerCellLog2 = 5;
   static const int kBitsPerBucket = kCellsPerBucket * kBitsPerCell;
   static const int kBitsPerBucketLog2 = kCellsPerBucketLog2 + kBitsPerCellLog2;
   static const int kBuckets = kMaxSlots / kCellsPerBucket / kBitsPerCell;
 
+  template <AccessMode access_mode>
+  void InsertMask(int bucket_index, int cell_index, uint32_t mask) {
+    Bucket bucket = LoadBucket<access_mode>(&buckets_[bucket_index]);
+    if (bucket == nullptr) {
+      bucket = AllocateBucket();
+      if (!SwapInNewBucket<access_mode>(&buckets_[bucket_index], bucket)) {
+        DeleteArray<uint32_t>(bucket);
+        bucket = LoadBucket<access_mode>(&buckets_[bucket_index]);
+      }
+    }
+    // Check that monotonicity is preserved, i.e., once a bucket is set we do
+    // not free it concurrently.
+    DCHECK_NOT_NULL(bucket);
+    DCHECK_EQ(bucket, LoadBucket<access_mode>(&buckets_[bucket_index]));
+    if ((LoadCell<access_mode>(&bucket[cell_index]) & mask) != mask) {
+      SetCellBits<access_mode>(&bucket[cell_index], mask);
+    }
+  }
+
   Bucket AllocateBucket() {
     Bucket result = NewArray<uint32_t>(kCellsPerBucket);
     for (int i = 0; i < kCellsPerBucket; i++) {
@@ -189,6 +189,9 @@ MemoryChunk* MemoryChunk::FromAnyPointerAddress(Heap* heap, Address addr) {
   uintptr_t offset = addr - chunk->address();
   if (offset < MemoryChunk::kHeaderSize || !chunk->HasPageHeader()) {
     chunk = heap->lo_space()->FindPageThreadSafe(addr);
+    if (chunk == nullptr) {
+      chunk = heap->new_lo_space()->FindPageThreadSafe(addr);
+    }
   }
   return chunk;
 }
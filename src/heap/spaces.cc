@@ -4,6 +4,7 @@
 
 #include "src/heap/spaces.h"
 
+#include <cmath>
 #include <utility>
 
 #include "src/base/bits.h"
@@ -13,6 +14,7 @@
 #include "src/counters.h"
 #include "src/heap/array-buffer-tracker.h"
 #include "src/heap/concurrent-marking.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/slot-set.h"
@@ -268,6 +270,101 @@ void CodeRange::ReleaseBlock(const FreeBlock* block) {
 }
 
 
+#ifdef V8_COMPRESS_POINTERS
+// -----------------------------------------------------------------------------
+// PtrComprCage
+
+PtrComprCage::PtrComprCage(Isolate* isolate)
+    : isolate_(isolate), base_(nullptr), next_slot_(0) {}
+
+bool PtrComprCage::SetUp() {
+  DCHECK(!virtual_memory_.IsReserved());
+  base::VirtualMemory reservation;
+  if (!AlignedAllocVirtualMemory(kPtrComprCageReservationSize,
+                                 kPtrComprCageBaseAlignment,
+                                 isolate_->heap()->GetRandomMmapAddr(),
+                                 &reservation)) {
+    return false;
+  }
+  base_ = ::RoundUp(static_cast<Address>(reservation.address()),
+                    kPtrComprCageBaseAlignment);
+  DCHECK_LE(base_ + kPtrComprCageReservationSize,
+            static_cast<Address>(reservation.end()));
+  LOG(isolate_, NewEvent("PtrComprCage", base_, kPtrComprCageReservationSize));
+  virtual_memory_.TakeControl(&reservation);
+  return true;
+}
+
+size_t PtrComprCage::ReserveSlots(size_t count) {
+  DCHECK_GT(count, 0);
+  // First fit, starting at the slot following the last reservation and
+  // wrapping around once.
+  for (size_t attempt = 0; attempt < 2; attempt++) {
+    size_t start = attempt == 0 ? next_slot_ : 0;
+    size_t end = attempt == 0 ? kNumberOfSlots : next_slot_;
+    size_t run = 0;
+    for (size_t i = start; i < end; i++) {
+      if (used_slots_.test(i)) {
+        run = 0;
+        continue;
+      }
+      if (++run == count) {
+        size_t first = i + 1 - count;
+        for (size_t j = first; j <= i; j++) used_slots_.set(j);
+        next_slot_ = (i + 1) % kNumberOfSlots;
+        return first;
+      }
+    }
+  }
+  return kNumberOfSlots;
+}
+
+void PtrComprCage::ReleaseSlots(size_t first, size_t count) {
+  DCHECK_LE(first + count, kNumberOfSlots);
+  for (size_t i = first; i < first + count; i++) {
+    DCHECK(used_slots_.test(i));
+    used_slots_.reset(i);
+  }
+}
+
+Address PtrComprCage::AllocateRawMemory(const size_t requested_size,
+                                        const size_t commit_size,
+                                        size_t* allocated) {
+  DCHECK_LE(commit_size, requested_size);
+  const size_t slots = ::RoundUp(requested_size, kSlotSize) / kSlotSize;
+  size_t first;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    first = ReserveSlots(slots);
+  }
+  if (first == kNumberOfSlots) {
+    *allocated = 0;
+    return nullptr;
+  }
+  Address start = base_ + first * kSlotSize;
+  if (!isolate_->heap()->memory_allocator()->CommitMemory(start, commit_size,
+                                                          NOT_EXECUTABLE)) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    ReleaseSlots(first, slots);
+    *allocated = 0;
+    return nullptr;
+  }
+  *allocated = slots * kSlotSize;
+  return start;
+}
+
+void PtrComprCage::FreeRawMemory(Address start, size_t length) {
+  DCHECK(IsAddressAligned(start, MemoryChunk::kAlignment));
+  DCHECK(contains(start));
+  const size_t slots = ::RoundUp(length, kSlotSize) / kSlotSize;
+  // Decommit before handing the slots back, so that a concurrent reservation
+  // of the same range cannot race with the uncommit.
+  virtual_memory_.Uncommit(start, slots * kSlotSize);
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  ReleaseSlots(SlotIndex(start), slots);
+}
+#endif  // V8_COMPRESS_POINTERS
+
 // -----------------------------------------------------------------------------
 // MemoryAllocator
 //
@@ -275,6 +372,9 @@ void CodeRange::ReleaseBlock(const FreeBlock* block) {
 MemoryAllocator::MemoryAllocator(Isolate* isolate)
     : isolate_(isolate),
       code_range_(nullptr),
+#ifdef V8_COMPRESS_POINTERS
+      ptr_compr_cage_(nullptr),
+#endif
       capacity_(0),
       size_(0),
       size_executable_(0),
@@ -291,6 +391,11 @@ bool MemoryAllocator::SetUp(size_t capacity, size_t code_range_size) {
   code_range_ = new CodeRange(isolate_);
   if (!code_range_->SetUp(code_range_size)) return false;
 
+#ifdef V8_COMPRESS_POINTERS
+  ptr_compr_cage_ = new PtrComprCage(isolate_);
+  if (!ptr_compr_cage_->SetUp()) return false;
+#endif
+
   return true;
 }
 
@@ -310,6 +415,11 @@ void MemoryAllocator::TearDown() {
 
   delete code_range_;
   code_range_ = nullptr;
+
+#ifdef V8_COMPRESS_POINTERS
+  delete ptr_compr_cage_;
+  ptr_compr_cage_ = nullptr;
+#endif
 }
 
 class MemoryAllocator::Unmapper::UnmapFreeMemoryTask : public CancelableTask {
@@ -327,7 +437,29 @@ class MemoryAllocator::Unmapper::UnmapFreeMemoryTask : public CancelableTask {
   DISALLOW_COPY_AND_ASSIGN(UnmapFreeMemoryTask);
 };
 
+size_t MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+    double bytes_per_ms, size_t max_chunks) {
+  double chunks = std::ceil(bytes_per_ms * kPoolAllocationWindowMs /
+                            MemoryChunk::kPageSize);
+  return static_cast<size_t>(Min(chunks, static_cast<double>(max_chunks)));
+}
+
+void MemoryAllocator::Unmapper::UpdatePoolSize() {
+  // The pool absorbs allocation bursts after a GC. The GC tracer is only
+  // accessible on the main thread, so the size is computed here and picked
+  // up by the unmapping tasks.
+  size_t max_chunks = 0;
+  if (FLAG_max_pooled_pages > 0 && !heap_->ShouldOptimizeForMemoryUsage()) {
+    max_chunks = PoolSizeForAllocationRate(
+        heap_->tracer()->CurrentAllocationThroughputInBytesPerMillisecond(),
+        static_cast<size_t>(FLAG_max_pooled_pages));
+  }
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  max_pooled_chunks_ = max_chunks;
+}
+
 void MemoryAllocator::Unmapper::FreeQueuedChunks() {
+  UpdatePoolSize();
   ReconsiderDelayedChunks();
   if (heap_->use_tasks() && FLAG_concurrent_sweeping) {
     if (concurrent_unmapping_tasks_active_ >= kMaxUnmapperTasks) {
@@ -359,14 +491,15 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
   MemoryChunk* chunk = nullptr;
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
-    bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
+    bool pooled = ShouldPoolChunkSafe(chunk);
+    if (pooled) chunk->SetFlag(MemoryChunk::POOLED);
     allocator_->PerformFreeMemory(chunk);
     if (pooled) AddMemoryChunkSafe<kPooled>(chunk);
   }
   if (mode == MemoryAllocator::Unmapper::FreeMode::kReleasePooled) {
-    // The previous loop uncommitted any pages marked as pooled and added them
-    // to the pooled list. In case of kReleasePooled we need to free them
-    // though.
+    // The previous loop uncommitted or discarded any pages marked as pooled
+    // and added them to the pooled list. In case of kReleasePooled we need to
+    // free them though.
     while ((chunk = GetMemoryChunkSafe<kPooled>()) != nullptr) {
       allocator_->Free<MemoryAllocator::kAlreadyPooled>(chunk);
     }
@@ -412,6 +545,16 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                          executable == EXECUTABLE)) {
     return false;
   }
+#ifdef V8_COMPRESS_POINTERS
+  // Committing maps fresh pages over the region, which drops any earlier
+  // advice, so every committed region of the cage is advised on its own.
+  // Chunks are packed first-fit, so adjacent pages tend to form huge page
+  // sized runs.
+  if (FLAG_transparent_huge_pages && ptr_compr_cage() != nullptr &&
+      ptr_compr_cage()->contains(base)) {
+    base::OS::AdviseHugePages(base, size);
+  }
+#endif
   UpdateAllocatedSpaceLimits(base, base + size);
   return true;
 }
@@ -437,6 +580,11 @@ void MemoryAllocator::FreeMemory(Address base, size_t size,
       code_range()->contains(static_cast<Address>(base))) {
     DCHECK(executable == EXECUTABLE);
     code_range()->FreeRawMemory(base, size);
+#ifdef V8_COMPRESS_POINTERS
+  } else if (ptr_compr_cage() != nullptr && ptr_compr_cage()->contains(base)) {
+    DCHECK(executable == NOT_EXECUTABLE);
+    ptr_compr_cage()->FreeRawMemory(base, size);
+#endif
   } else {
     DCHECK(executable == NOT_EXECUTABLE || !code_range()->valid());
     bool result = base::VirtualMemory::ReleaseRegion(base, size);
@@ -686,7 +834,8 @@ bool MemoryChunk::CommitArea(size_t requested) {
 }
 
 size_t MemoryChunk::CommittedPhysicalMemory() {
-  if (!base::VirtualMemory::HasLazyCommits() || owner()->identity() == LO_SPACE)
+  if (!base::VirtualMemory::HasLazyCommits() ||
+      owner()->identity() == LO_SPACE || owner()->identity() == NEW_LO_SPACE)
     return size();
   return high_water_mark_.Value();
 }
@@ -801,11 +950,28 @@ MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
     size_t commit_size =
         ::RoundUp(MemoryChunk::kObjectStartOffset + commit_area_size,
                   GetCommitPageSize());
-    base =
-        AllocateAlignedMemory(chunk_size, commit_size, MemoryChunk::kAlignment,
-                              executable, address_hint, &reservation);
+#ifdef V8_COMPRESS_POINTERS
+    // Chunks in the cage do not own a reservation, just like chunks in the
+    // code range. The cage picks their place, so |address_hint| is not used.
+    base = ptr_compr_cage()->AllocateRawMemory(chunk_size, commit_size,
+                                               &chunk_size);
+    if (base == NULL) return NULL;
+    size_.Increment(chunk_size);
+#else
+    // Large chunks are aligned to huge page boundaries so that as much of
+    // their area as possible can be backed by huge pages. Regular pages are
+    // smaller than a huge page and get their own reservation, so they are
+    // not advised; only the cage packs them into huge page sized runs.
+    bool use_huge_pages =
+        FLAG_transparent_huge_pages && chunk_size >= kHugePageSize;
+    size_t alignment =
+        use_huge_pages ? kHugePageSize : MemoryChunk::kAlignment;
+    base = AllocateAlignedMemory(chunk_size, commit_size, alignment, executable,
+                                 address_hint, &reservation);
 
     if (base == NULL) return NULL;
+    if (use_huge_pages) base::OS::AdviseHugePages(base, chunk_size);
+#endif
 
     if (Heap::ShouldZapGarbage()) {
       ZapBlock(base, Page::kObjectStartOffset + commit_area_size);
@@ -987,7 +1153,11 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   base::VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitBlock(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize);
+    if (unmapper()->discard_pooled_chunks()) {
+      DiscardBlock(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize);
+    } else {
+      UncommitBlock(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize);
+    }
   } else {
     if (reservation->IsReserved()) {
       FreeMemory(reservation, chunk->executable());
@@ -1005,7 +1175,8 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
       PerformFreeMemory(chunk);
       break;
     case kAlreadyPooled:
-      // Pooled pages cannot be touched anymore as their memory is uncommitted.
+      // Pooled pages cannot be touched anymore as their memory is uncommitted
+      // or discarded.
       FreeMemory(chunk->address(), static_cast<size_t>(MemoryChunk::kPageSize),
                  Executability::NOT_EXECUTABLE);
       break;
@@ -1056,6 +1227,9 @@ template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    size_t size, PagedSpace* owner, Executability executable);
+template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 
@@ -1075,10 +1249,21 @@ MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
   const Address start = reinterpret_cast<Address>(chunk);
   const Address area_start = start + MemoryChunk::kObjectStartOffset;
   const Address area_end = start + size;
-  if (!CommitBlock(reinterpret_cast<Address>(chunk), size, NOT_EXECUTABLE)) {
+  if (unmapper()->discard_pooled_chunks()) {
+    // Discarded chunks are still committed, but their contents are
+    // undefined. Like freshly committed chunks, they are fully initialized
+    // by MemoryChunk::Initialize and the owning space.
+    isolate_->counters()->memory_allocated()->Increment(size);
+    if (Heap::ShouldZapGarbage()) ZapBlock(start, size);
+  } else if (!CommitBlock(start, size, NOT_EXECUTABLE)) {
     return nullptr;
   }
+#ifdef V8_COMPRESS_POINTERS
+  // The memory is owned by the cage and must not be released on its own.
+  base::VirtualMemory reservation;
+#else
   base::VirtualMemory reservation(start, size);
+#endif
   MemoryChunk::Initialize(isolate_->heap(), start, size, area_start, area_end,
                           NOT_EXECUTABLE, owner, &reservation);
   size_.Increment(size);
@@ -1104,6 +1289,11 @@ bool MemoryAllocator::UncommitBlock(Address start, size_t size) {
   return true;
 }
 
+bool MemoryAllocator::DiscardBlock(Address start, size_t size) {
+  isolate_->counters()->memory_allocated()->Decrement(static_cast<int>(size));
+  return base::OS::DiscardSystemPages(start, size);
+}
+
 
 void MemoryAllocator::ZapBlock(Address start, size_t size) {
   for (size_t s = 0; s + kPointerSize <= size; s += kPointerSize) {
@@ -1564,8 +1754,15 @@ bool PagedSpace::Expand() {
 
   if (!heap()->CanExpandOldGeneration(size)) return false;
 
-  Page* page =
-      heap()->memory_allocator()->AllocatePage(size, this, executable());
+  Page* page = nullptr;
+  if (executable() == NOT_EXECUTABLE &&
+      size == static_cast<int>(Page::kAllocatableMemory)) {
+    // Regular pages are taken from the unmapper's pool if possible.
+    page = heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+        size, this, NOT_EXECUTABLE);
+  } else {
+    page = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  }
   if (page == nullptr) return false;
   // Pages created during bootstrapping may contain immortal immovable objects.
   if (!heap()->deserialization_complete()) page->MarkNeverEvacuate();
@@ -3213,7 +3410,9 @@ void MapSpace::VerifyObject(HeapObject* object) { CHECK(object->IsMap()); }
 
 Address LargePage::GetAddressToShrink(Address object_address,
                                       size_t object_size) {
-  if (executable() == EXECUTABLE) {
+  // Chunks without their own reservation (e.g. in the code range or the
+  // pointer compression cage) cannot be partially released.
+  if (executable() == EXECUTABLE || !reserved_memory()->IsReserved()) {
     return 0;
   }
   size_t used_size = ::RoundUp((object_address - address()) + object_size,
@@ -3292,14 +3491,7 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
   if (page == NULL) return AllocationResult::Retry(identity());
   DCHECK_GE(page->area_size(), static_cast<size_t>(object_size));
 
-  size_ += static_cast<int>(page->size());
-  AccountCommitted(page->size());
-  objects_size_ += object_size;
-  page_count_++;
-  page->set_next_page(first_page_);
-  first_page_ = page;
-
-  InsertChunkMapEntries(page);
+  AddPage(page, object_size);
 
   HeapObject* object = page->GetObject();
 
@@ -3326,6 +3518,51 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
 }
 
 
+void LargeObjectSpace::AddPage(LargePage* page, size_t object_size) {
+  size_ += static_cast<int>(page->size());
+  AccountCommitted(page->size());
+  objects_size_ += object_size;
+  page_count_++;
+  page->set_next_page(first_page_);
+  first_page_ = page;
+
+  InsertChunkMapEntries(page);
+}
+
+void LargeObjectSpace::RemovePage(LargePage* page, size_t object_size) {
+  size_ -= static_cast<int>(page->size());
+  AccountUncommitted(page->size());
+  DCHECK_GE(objects_size_, object_size);
+  objects_size_ -= object_size;
+  page_count_--;
+
+  if (first_page_ == page) {
+    first_page_ = page->next_page();
+  } else {
+    LargePage* previous = first_page_;
+    while (previous->next_page() != page) previous = previous->next_page();
+    previous->set_next_page(page->next_page());
+  }
+  page->set_next_page(nullptr);
+
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
+  RemoveChunkMapEntries(page);
+}
+
+void LargeObjectSpace::PromoteNewLargeObject(LargePage* page) {
+  DCHECK_EQ(LO_SPACE, identity());
+  DCHECK_EQ(NEW_LO_SPACE, page->owner()->identity());
+  DCHECK(page->InNewSpace());
+  size_t object_size = static_cast<size_t>(page->GetObject()->Size());
+  static_cast<LargeObjectSpace*>(page->owner())->RemovePage(page,
+                                                            object_size);
+  page->ClearFlag(MemoryChunk::IN_FROM_SPACE);
+  page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetOldSpacePageFlags(page);
+  page->set_owner(this);
+  AddPage(page, object_size);
+}
+
 size_t LargeObjectSpace::CommittedPhysicalMemory() {
   // On a platform that provides lazy committing of memory, we over-account
   // the actually committed memory. There is no easy way right now to support
@@ -3533,6 +3770,59 @@ void LargeObjectSpace::Verify() {
 }
 #endif
 
+NewLargeObjectSpace::NewLargeObjectSpace(Heap* heap)
+    : LargeObjectSpace(heap, NEW_LO_SPACE) {}
+
+AllocationResult NewLargeObjectSpace::AllocateRaw(int object_size) {
+  // Surviving objects are promoted without copying, so the old generation
+  // has to be able to take all of them.
+  if (!heap()->CanExpandOldGeneration(SizeOfObjects() + object_size)) {
+    return AllocationResult::Retry(LO_SPACE);
+  }
+  // A scavenge frees or promotes all objects of this space. The first object
+  // is always allocated to guarantee progress.
+  if (page_count_ > 0 && static_cast<size_t>(object_size) > Available()) {
+    return AllocationResult::Retry(NEW_SPACE);
+  }
+
+  LargePage* page = heap()->memory_allocator()->AllocateLargePage(
+      object_size, this, NOT_EXECUTABLE);
+  if (page == nullptr) return AllocationResult::Retry(LO_SPACE);
+  DCHECK_GE(page->area_size(), static_cast<size_t>(object_size));
+
+  page->SetFlag(MemoryChunk::IN_TO_SPACE);
+  heap()->incremental_marking()->SetNewSpacePageFlags(page);
+  AddPage(page, object_size);
+
+  HeapObject* object = page->GetObject();
+  heap()->CreateFillerObjectAt(object->address(), object_size,
+                               ClearRecordedSlots::kNo);
+  AllocationStep(object->address(), object_size);
+  return object;
+}
+
+size_t NewLargeObjectSpace::Available() {
+  size_t capacity = heap()->new_space()->Capacity();
+  return capacity > SizeOfObjects() ? capacity - SizeOfObjects() : 0;
+}
+
+void NewLargeObjectSpace::Flip() {
+  for (LargePage* page : *this) {
+    page->SetFlag(MemoryChunk::IN_FROM_SPACE);
+    page->ClearFlag(MemoryChunk::IN_TO_SPACE);
+  }
+}
+
+void NewLargeObjectSpace::FreeAllObjects() {
+  while (first_page_ != nullptr) {
+    LargePage* page = first_page_;
+    RemovePage(page, static_cast<size_t>(page->GetObject()->Size()));
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  }
+  // Right-trimming does not update the accounted object size.
+  objects_size_ = 0;
+}
+
 #ifdef DEBUG
 void LargeObjectSpace::Print() {
   OFStream os(stdout);
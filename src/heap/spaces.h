@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_SPACES_H_
 #define V8_HEAP_SPACES_H_
 
+#include <bitset>
 #include <list>
 #include <map>
 #include <memory>
@@ -289,8 +290,9 @@ class MemoryChunk {
     // still has to be performed.
     PRE_FREED = 1u << 13,
 
-    // |POOLED|: When actually freeing this chunk, only uncommit and do not
-    // give up the reservation as we still reuse the chunk at some point.
+    // |POOLED|: When actually freeing this chunk, only uncommit or discard it
+    // and do not give up the reservation as we still reuse the chunk at some
+    // point.
     POOLED = 1u << 14,
 
     // |COMPACTION_WAS_ABORTED|: Indicates that the compaction in this page
@@ -1089,6 +1091,69 @@ class CodeRange {
   DISALLOW_COPY_AND_ASSIGN(CodeRange);
 };
 
+#ifdef V8_COMPRESS_POINTERS
+// ----------------------------------------------------------------------------
+// A PtrComprCage is a single kPtrComprCageReservationSize range of virtual
+// memory whose base is kPtrComprCageBaseAlignment aligned. All non-executable
+// memory chunks are carved out of it. This only provides the memory layout
+// that pointer compression needs; tagged fields are still full pointers.
+class PtrComprCage {
+ public:
+  explicit PtrComprCage(Isolate* isolate);
+  ~PtrComprCage() {
+    if (virtual_memory_.IsReserved()) virtual_memory_.Release();
+  }
+
+  // Reserves the cage, but does not commit any of it. Can only be called once,
+  // at heap initialization time. Returns false on failure.
+  bool SetUp();
+
+  bool valid() { return virtual_memory_.IsReserved(); }
+  Address base() {
+    DCHECK(valid());
+    return base_;
+  }
+  bool contains(Address address) {
+    if (!valid()) return false;
+    return base_ <= address && address < base_ + kPtrComprCageReservationSize;
+  }
+
+  // Reserves a chunk of at least |requested_size| bytes aligned to
+  // MemoryChunk::kAlignment and commits its first |commit_size| bytes. The
+  // actually reserved size is stored in |allocated|.
+  MUST_USE_RESULT Address AllocateRawMemory(const size_t requested_size,
+                                            const size_t commit_size,
+                                            size_t* allocated);
+  void FreeRawMemory(Address start, size_t length);
+
+ private:
+  static const size_t kSlotSize = static_cast<size_t>(MemoryChunk::kAlignment);
+  static const size_t kNumberOfSlots =
+      kPtrComprCageReservationSize / MemoryChunk::kAlignment;
+
+  size_t SlotIndex(Address address) {
+    return static_cast<size_t>(address - base_) / kSlotSize;
+  }
+
+  // Finds |count| consecutive free slots, marks them as used and returns the
+  // index of the first one. Returns kNumberOfSlots if the cage is exhausted.
+  size_t ReserveSlots(size_t count);
+  void ReleaseSlots(size_t first, size_t count);
+
+  Isolate* isolate_;
+  base::VirtualMemory virtual_memory_;
+  Address base_;
+
+  // Guards used_slots_ and next_slot_ as pages may be released concurrently
+  // by the Unmapper.
+  base::Mutex mutex_;
+  std::bitset<kNumberOfSlots> used_slots_;
+  size_t next_slot_;
+
+  DISALLOW_COPY_AND_ASSIGN(PtrComprCage);
+};
+#endif  // V8_COMPRESS_POINTERS
+
 
 class SkipList {
  public:
@@ -1155,11 +1220,17 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
    public:
     class UnmapFreeMemoryTask;
 
+    // Pooled pages cover the allocations of this many milliseconds at the
+    // current allocation rate, bounded by --max-pooled-pages.
+    static const int kPoolAllocationWindowMs = 100;
+
     Unmapper(Heap* heap, MemoryAllocator* allocator)
         : heap_(heap),
           allocator_(allocator),
           pending_unmapping_tasks_semaphore_(0),
-          concurrent_unmapping_tasks_active_(0) {
+          concurrent_unmapping_tasks_active_(0),
+          discard_pooled_chunks_(FLAG_discard_pooled_pages),
+          max_pooled_chunks_(0) {
       chunks_[kRegular].reserve(kReservedQueueingSlots);
       chunks_[kPooled].reserve(kReservedQueueingSlots);
     }
@@ -1196,6 +1267,25 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
 
     bool has_delayed_chunks() { return delayed_regular_chunks_.size() > 0; }
 
+    // Pooled chunks are either uncommitted or stay committed with their
+    // memory discarded, in which case they do not need to be committed again
+    // when they are reused.
+    bool discard_pooled_chunks() const { return discard_pooled_chunks_; }
+
+    // The number of regular chunks that are kept for reuse instead of being
+    // unmapped. Chunks that were explicitly freed as pooled are always kept.
+    size_t max_pooled_chunks() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return max_pooled_chunks_;
+    }
+    size_t NumberOfPooledChunks() {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return chunks_[kPooled].size();
+    }
+
+    static size_t PoolSizeForAllocationRate(double bytes_per_ms,
+                                            size_t max_chunks);
+
    private:
     static const int kReservedQueueingSlots = 64;
     static const int kMaxUnmapperTasks = 24;
@@ -1204,7 +1294,8 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
       kRegular,     // Pages of kPageSize that do not live in a CodeRange and
                     // can thus be used for stealing.
       kNonRegular,  // Large chunks and executable chunks.
-      kPooled,      // Pooled chunks, already uncommited and ready for reuse.
+      kPooled,      // Pooled chunks, already uncommited or discarded and
+                    // ready for reuse.
       kNumberOfChunkQueues,
     };
 
@@ -1233,6 +1324,15 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
       return chunk;
     }
 
+    // Returns true if the regular |chunk| should be added to the pool
+    // instead of being unmapped.
+    bool ShouldPoolChunkSafe(MemoryChunk* chunk) {
+      if (chunk->IsFlagSet(MemoryChunk::POOLED)) return true;
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      return chunks_[kPooled].size() < max_pooled_chunks_;
+    }
+
+    void UpdatePoolSize();
     void ReconsiderDelayedChunks();
     template <FreeMode mode>
     void PerformFreeMemoryOnQueuedChunks();
@@ -1248,10 +1348,18 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
     CancelableTaskManager::Id task_ids_[kMaxUnmapperTasks];
     base::Semaphore pending_unmapping_tasks_semaphore_;
     intptr_t concurrent_unmapping_tasks_active_;
+    const bool discard_pooled_chunks_;
+    // Updated on the main thread and read by the unmapping tasks, guarded by
+    // |mutex_|.
+    size_t max_pooled_chunks_;
 
     friend class MemoryAllocator;
   };
 
+  // Size of a transparent huge page. Chunks at least this large are aligned
+  // to it when --transparent-huge-pages is enabled.
+  static const size_t kHugePageSize = 2 * MB;
+
   enum AllocationMode {
     kRegular,
     kPooled,
@@ -1367,6 +1475,11 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
   // and false otherwise.
   bool UncommitBlock(Address start, size_t size);
 
+  // Releases the physical memory of [start..(start+size)[ but keeps the block
+  // committed, so that it can be reused without another mmap. Returns false
+  // if the OS did not accept the hint; the memory is still usable then.
+  bool DiscardBlock(Address start, size_t size);
+
   // Zaps a contiguous block of memory [start..(start+size)[ thus
   // filling it up with a recognizable non-NULL bit pattern.
   void ZapBlock(Address start, size_t size);
@@ -1376,6 +1489,9 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
                                               size_t reserved_size);
 
   CodeRange* code_range() { return code_range_; }
+#ifdef V8_COMPRESS_POINTERS
+  PtrComprCage* ptr_compr_cage() { return ptr_compr_cage_; }
+#endif
   Unmapper* unmapper() { return &unmapper_; }
 
 #ifdef DEBUG
@@ -1418,6 +1534,9 @@ class V8_EXPORT_PRIVATE MemoryAllocator {
 
   Isolate* isolate_;
   CodeRange* code_range_;
+#ifdef V8_COMPRESS_POINTERS
+  PtrComprCage* ptr_compr_cage_;
+#endif
 
   // Maximum space size in bytes.
   size_t capacity_;
@@ -1450,6 +1569,9 @@ extern template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 extern template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    size_t size, PagedSpace* owner, Executability executable);
+extern template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
     size_t size, SemiSpace* owner, Executability executable);
 
@@ -2924,6 +3046,10 @@ class LargeObjectSpace : public Space {
   // Frees unmarked objects.
   void FreeUnmarkedObjects();
 
+  // Moves the page of a young large object from the new large object space to
+  // this space. The object itself is not copied.
+  void PromoteNewLargeObject(LargePage* page);
+
   void InsertChunkMapEntries(LargePage* page);
   void RemoveChunkMapEntries(LargePage* page);
   void RemoveChunkMapEntries(LargePage* page, Address free_start);
@@ -2956,7 +3082,12 @@ class LargeObjectSpace : public Space {
   void ReportStatistics();
 #endif
 
- private:
+ protected:
+  // Links a freshly allocated or promoted page into this space and accounts
+  // for its memory.
+  void AddPage(LargePage* page, size_t object_size);
+  void RemovePage(LargePage* page, size_t object_size);
+
   // The head of the linked list of large object chunks.
   LargePage* first_page_;
   size_t size_;            // allocated bytes
@@ -2971,6 +3102,31 @@ class LargeObjectSpace : public Space {
   friend class LargeObjectIterator;
 };
 
+// The new large object space holds large objects that were allocated in the
+// young generation. Its pages carry the new space page flags, so the write
+// barrier and the remembered sets treat the objects like any other young
+// object. Scavenges never copy these objects: survivors are promoted by moving
+// their page to the old large object space and the remaining objects are
+// freed. The space is empty during mark-compact, which promotes all young
+// large objects before marking.
+class NewLargeObjectSpace : public LargeObjectSpace {
+ public:
+  explicit NewLargeObjectSpace(Heap* heap);
+
+  // Fails when the objects of this space exceed the capacity of the new
+  // space, so that a scavenge is triggered.
+  MUST_USE_RESULT AllocationResult AllocateRaw(int object_size);
+
+  // Available bytes for objects in this space.
+  size_t Available() override;
+
+  // Turns all pages into from-space pages at the start of a scavenge.
+  void Flip();
+
+  // Frees the objects that were not promoted by the last scavenge.
+  void FreeAllObjects();
+};
+
 
 class LargeObjectIterator : public ObjectIterator {
  public:
@@ -104,31 +104,50 @@ void StoreBuffer::MoveEntriesToRememberedSet(int index) {
   if (!lazy_top_[index]) return;
   DCHECK_GE(index, 0);
   DCHECK_LT(index, kStoreBuffers);
-  Address last_inserted_addr = nullptr;
+  // Consecutive entries mostly belong to the same chunk and often to the same
+  // slot set cell. The chunk is cached to avoid the large object space lookup
+  // and insertions into the same cell are coalesced into a single update.
+  const uintptr_t kCellSize = SlotSet::kBitsPerCell * kPointerSize;
+  MemoryChunk* chunk = nullptr;
+  Address cell_start = nullptr;
+  uint32_t cell_mask = 0;
   for (Address* current = start_[index]; current < lazy_top_[index];
        current++) {
     Address addr = *current;
-    Page* page = Page::FromAnyPointerAddress(heap_, addr);
-    if (IsDeletionAddress(addr)) {
-      last_inserted_addr = nullptr;
+    bool is_deletion = IsDeletionAddress(addr);
+    if (is_deletion) addr = UnmarkDeletionAddress(addr);
+    if (!is_deletion && cell_mask != 0 &&
+        (reinterpret_cast<uintptr_t>(addr) & ~(kCellSize - 1)) ==
+            reinterpret_cast<uintptr_t>(cell_start)) {
+      cell_mask |= 1u << ((addr - cell_start) >> kPointerSizeLog2);
+      continue;
+    }
+    if (cell_mask != 0) {
+      RememberedSet<OLD_TO_NEW>::InsertCell(chunk, cell_start, cell_mask);
+      cell_mask = 0;
+    }
+    if (chunk == nullptr || !chunk->Contains(addr)) {
+      chunk = MemoryChunk::FromAnyPointerAddress(heap_, addr);
+    }
+    if (is_deletion) {
       current++;
       Address end = *current;
       DCHECK(!IsDeletionAddress(end));
-      addr = UnmarkDeletionAddress(addr);
       if (end) {
-        RememberedSet<OLD_TO_NEW>::RemoveRange(page, addr, end,
+        RememberedSet<OLD_TO_NEW>::RemoveRange(chunk, addr, end,
                                                SlotSet::PREFREE_EMPTY_BUCKETS);
       } else {
-        RememberedSet<OLD_TO_NEW>::Remove(page, addr);
+        RememberedSet<OLD_TO_NEW>::Remove(chunk, addr);
       }
     } else {
-      DCHECK(!IsDeletionAddress(addr));
-      if (addr != last_inserted_addr) {
-        RememberedSet<OLD_TO_NEW>::Insert(page, addr);
-        last_inserted_addr = addr;
-      }
+      cell_start = reinterpret_cast<Address>(
+          reinterpret_cast<uintptr_t>(addr) & ~(kCellSize - 1));
+      cell_mask = 1u << ((addr - cell_start) >> kPointerSizeLog2);
     }
   }
+  if (cell_mask != 0) {
+    RememberedSet<OLD_TO_NEW>::InsertCell(chunk, cell_start, cell_mask);
+  }
   lazy_top_[index] = nullptr;
 }
 
@@ -1179,6 +1179,75 @@ void InterpreterAssembler::InlineStar() {
   accumulator_use_ = previous_acc_use;
 }
 
+Node* InterpreterAssembler::JumpIfDispatchLookahead(Node* target_bytecode) {
+  Label do_inline_jump_if_true(this), do_inline_jump_if_false(this),
+      done(this);
+
+  Variable var_bytecode(this, MachineType::PointerRepresentation());
+  var_bytecode.Bind(target_bytecode);
+
+  Node* jump_if_true_bytecode =
+      IntPtrConstant(static_cast<int>(Bytecode::kJumpIfTrue));
+  Node* jump_if_false_bytecode =
+      IntPtrConstant(static_cast<int>(Bytecode::kJumpIfFalse));
+  GotoIf(WordEqual(target_bytecode, jump_if_true_bytecode),
+         &do_inline_jump_if_true);
+  Branch(WordEqual(target_bytecode, jump_if_false_bytecode),
+         &do_inline_jump_if_false, &done);
+
+  BIND(&do_inline_jump_if_true);
+  {
+    InlineJumpIf(Bytecode::kJumpIfTrue);
+    var_bytecode.Bind(LoadBytecode(BytecodeOffset()));
+    Goto(&done);
+  }
+  BIND(&do_inline_jump_if_false);
+  {
+    InlineJumpIf(Bytecode::kJumpIfFalse);
+    var_bytecode.Bind(LoadBytecode(BytecodeOffset()));
+    Goto(&done);
+  }
+  BIND(&done);
+  return var_bytecode.value();
+}
+
+void InterpreterAssembler::InlineJumpIf(Bytecode jump_bytecode) {
+  DCHECK(jump_bytecode == Bytecode::kJumpIfTrue ||
+         jump_bytecode == Bytecode::kJumpIfFalse);
+  Bytecode previous_bytecode = bytecode_;
+  AccumulatorUse previous_acc_use = accumulator_use_;
+
+  bytecode_ = jump_bytecode;
+  accumulator_use_ = AccumulatorUse::kNone;
+
+#ifdef V8_TRACE_IGNITION
+  TraceBytecode(Runtime::kInterpreterTraceBytecodeEntry);
+#endif
+  Node* relative_jump = BytecodeOperandUImmWord(0);
+  Node* condition_value =
+      BooleanConstant(jump_bytecode == Bytecode::kJumpIfTrue);
+  Label if_jump(this), if_nojump(this), done(this);
+  Branch(WordEqual(GetAccumulator(), condition_value), &if_jump, &if_nojump);
+
+  BIND(&if_jump);
+  {
+    UpdateInterruptBudget(TruncateWordToWord32(relative_jump), false);
+    Advance(relative_jump);
+    Goto(&done);
+  }
+  BIND(&if_nojump);
+  {
+    Advance();
+    Goto(&done);
+  }
+  BIND(&done);
+
+  DCHECK_EQ(accumulator_use_, Bytecodes::GetAccumulatorUse(bytecode_));
+
+  bytecode_ = previous_bytecode;
+  accumulator_use_ = previous_acc_use;
+}
+
 Node* InterpreterAssembler::Dispatch() {
   Comment("========= Dispatch");
   DCHECK_IMPLIES(Bytecodes::MakesCallAlongCriticalPath(bytecode_), made_call_);
@@ -1187,6 +1256,8 @@ Node* InterpreterAssembler::Dispatch() {
 
   if (Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
     target_bytecode = StarDispatchLookahead(target_bytecode);
+  } else if (Bytecodes::IsJumpIfLookahead(bytecode_, operand_scale_)) {
+    target_bytecode = JumpIfDispatchLookahead(target_bytecode);
   }
   return DispatchToBytecode(target_bytecode, BytecodeOffset());
 }
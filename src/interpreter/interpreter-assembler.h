@@ -341,6 +341,15 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   // next dispatch offset.
   void InlineStar();
 
+  // Look ahead for JumpIfTrue and JumpIfFalse and inline them in a branch.
+  // Returns a new target bytecode node for dispatch.
+  compiler::Node* JumpIfDispatchLookahead(compiler::Node* target_bytecode);
+
+  // Build code for the conditional |jump_bytecode| at the current
+  // BytecodeOffset() and Advance() to the next dispatch offset, which is the
+  // jump target if the jump is taken.
+  void InlineJumpIf(Bytecode jump_bytecode);
+
   // Dispatch to |target_bytecode| at |new_bytecode_offset|.
   // |target_bytecode| should be equivalent to loading from the offset.
   compiler::Node* DispatchToBytecode(compiler::Node* target_bytecode,
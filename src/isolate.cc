@@ -30,6 +30,7 @@
 #include "src/deoptimizer.h"
 #include "src/elements.h"
 #include "src/external-reference-table.h"
+#include "src/feedback-profile.h"
 #include "src/frames-inl.h"
 #include "src/ic/access-compiler-data.h"
 #include "src/ic/stub-cache.h"
@@ -2315,6 +2316,7 @@ Isolate::Isolate(bool enable_serializer)
       bootstrapper_(NULL),
       runtime_profiler_(NULL),
       compilation_cache_(NULL),
+      feedback_profile_(NULL),
       logger_(NULL),
       load_stub_cache_(NULL),
       store_stub_cache_(NULL),
@@ -2585,6 +2587,8 @@ Isolate::~Isolate() {
 
   delete compilation_cache_;
   compilation_cache_ = NULL;
+  delete feedback_profile_;
+  feedback_profile_ = NULL;
   delete bootstrapper_;
   bootstrapper_ = NULL;
   delete inner_pointer_to_code_cache_;
@@ -2714,6 +2718,7 @@ bool Isolate::Init(StartupDeserializer* des) {
 #undef ASSIGN_ELEMENT
 
   compilation_cache_ = new CompilationCache(this);
+  feedback_profile_ = new FeedbackProfile();
   context_slot_cache_ = new ContextSlotCache();
   descriptor_lookup_cache_ = new DescriptorLookupCache();
   unicode_cache_ = new UnicodeCache();
@@ -21,6 +21,7 @@
 #include "src/ast/ast.h"
 #include "src/ast/scopes.h"
 #include "src/base/bits.h"
+#include "src/base/optional.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/bootstrapper.h"
 #include "src/builtins/builtins.h"
@@ -41,6 +42,7 @@
 #include "src/field-type.h"
 #include "src/frames-inl.h"
 #include "src/globals.h"
+#include "src/heap/array-buffer-pool.h"
 #include "src/ic/ic.h"
 #include "src/identity-map.h"
 #include "src/interpreter/bytecode-array-iterator.h"
@@ -2693,6 +2695,12 @@ bool String::MakeExternal(v8::String::ExternalStringResource* resource) {
     heap->ClearRecordedSlotRange(this->address(), this->address() + new_size);
   }
 
+  // Background threads may be comparing an internalized string with a parsed
+  // one, see StringTable::ConcurrentFindEntry. They must not see the new map
+  // before the resource is set.
+  base::Optional<StringTableWriteScope> write_scope;
+  if (is_internalized) write_scope.emplace(heap);
+
   // We are storing the new map using release store after creating a filler for
   // the left-over space to avoid races with the sweeper thread.
   this->synchronized_set_map(new_map);
@@ -2762,6 +2770,12 @@ bool String::MakeExternal(v8::String::ExternalOneByteStringResource* resource) {
     heap->ClearRecordedSlotRange(this->address(), this->address() + new_size);
   }
 
+  // Background threads may be comparing an internalized string with a parsed
+  // one, see StringTable::ConcurrentFindEntry. They must not see the new map
+  // before the resource is set.
+  base::Optional<StringTableWriteScope> write_scope;
+  if (is_internalized) write_scope.emplace(heap);
+
   // We are storing the new map using release store after creating a filler for
   // the left-over space to avoid races with the sweeper thread.
   this->synchronized_set_map(new_map);
@@ -13331,6 +13345,15 @@ bool Script::GetPositionInfo(Handle<Script> script, int position,
 
 bool Script::IsUserJavaScript() { return type() == Script::TYPE_NORMAL; }
 
+bool Script::ContainsAsmModule() {
+  DisallowHeapAllocation no_gc;
+  SharedFunctionInfo::ScriptIterator iter(Handle<Script>(this));
+  while (SharedFunctionInfo* info = iter.Next()) {
+    if (info->HasAsmWasmData()) return true;
+  }
+  return false;
+}
+
 namespace {
 bool GetPositionInfoSlow(const Script* script, int position,
                          Script::PositionInfo* info) {
@@ -16943,12 +16966,17 @@ Handle<String> StringTable::LookupKey(Isolate* isolate, StringTableKey* key) {
   CHECK(!string.is_null());
   DCHECK(string->HasHashCode());
 
-  // Add the new string and return it along with the string table.
-  entry = table->FindInsertionEntry(key->Hash());
-  table->set(EntryToIndex(entry), *string);
-  table->ElementAdded();
+  // Add the new string and return it along with the string table. A grown
+  // table was filled by EnsureCapacity without the lock; that is safe because
+  // background threads only see it once it is published here.
+  {
+    StringTableWriteScope write_scope(isolate->heap());
+    entry = table->FindInsertionEntry(key->Hash());
+    table->set(EntryToIndex(entry), *string);
+    table->ElementAdded();
 
-  isolate->heap()->SetRootStringTable(*table);
+    isolate->heap()->SetRootStringTable(*table);
+  }
   return Handle<String>::cast(string);
 }
 
@@ -17117,6 +17145,37 @@ String* StringTable::LookupKeyIfExists(Isolate* isolate, StringTableKey* key) {
   return NULL;
 }
 
+// static
+int StringTable::ConcurrentFindEntry(Heap* heap, StringTableKey* key) {
+  DisallowHeapAllocation no_gc;
+  DCHECK(FLAG_concurrent_string_table_lookup);
+  base::LockGuard<base::Mutex> guard(heap->relocation_mutex());
+  return heap->string_table()->FindEntry(heap->isolate(), key);
+}
+
+// static
+String* StringTable::KeyAtEntryIfMatches(Isolate* isolate,
+                                         StringTableKey* key, int entry) {
+  DisallowHeapAllocation no_gc;
+  StringTable* table = isolate->heap()->string_table();
+  if (entry == kNotFound || entry >= table->Capacity()) return nullptr;
+  Object* element = table->KeyAt(entry);
+  if (!element->IsString()) return nullptr;
+  String* string = String::cast(element);
+  if (string->Hash() != key->Hash() || !key->IsMatch(string)) return nullptr;
+  return string;
+}
+
+StringTableWriteScope::StringTableWriteScope(Heap* heap)
+    : mutex_(FLAG_concurrent_string_table_lookup ? heap->relocation_mutex()
+                                                 : nullptr) {
+  if (mutex_ != nullptr) mutex_->Lock();
+}
+
+StringTableWriteScope::~StringTableWriteScope() {
+  if (mutex_ != nullptr) mutex_->Unlock();
+}
+
 Handle<StringSet> StringSet::New(Isolate* isolate) {
   return HashTable::New(isolate, 0);
 }
@@ -18919,10 +18978,9 @@ void JSArrayBuffer::FreeBackingStore() {
   if (allocation_base() == nullptr) {
     return;
   }
-  using AllocationMode = ArrayBuffer::Allocator::AllocationMode;
-  const size_t length = allocation_length();
-  const AllocationMode mode = allocation_mode();
-  GetIsolate()->array_buffer_allocator()->Free(allocation_base(), length, mode);
+  FreeBackingStore(GetIsolate(), Allocation(allocation_base(),
+                                            allocation_length(),
+                                            allocation_mode()));
 
   // Zero out the backing store and allocation base to avoid dangling
   // pointers.
@@ -18934,6 +18992,11 @@ void JSArrayBuffer::FreeBackingStore() {
   set_allocation_length(0);
 }
 
+// static
+void JSArrayBuffer::FreeBackingStore(Isolate* isolate, Allocation allocation) {
+  isolate->heap()->array_buffer_pool()->Free(allocation);
+}
+
 void JSArrayBuffer::Setup(Handle<JSArrayBuffer> array_buffer, Isolate* isolate,
                           bool is_external, void* data, size_t allocated_length,
                           SharedFlag shared) {
@@ -18994,11 +19057,15 @@ bool JSArrayBuffer::SetupAllocatingData(Handle<JSArrayBuffer> array_buffer,
     if (shared == SharedFlag::kShared)
       isolate->counters()->shared_array_allocations()->AddSample(
           ConvertToMb(allocated_length));
-    if (initialize) {
-      data = isolate->array_buffer_allocator()->Allocate(allocated_length);
-    } else {
-      data = isolate->array_buffer_allocator()->AllocateUninitialized(
-          allocated_length);
+    data = isolate->heap()->array_buffer_pool()->Allocate(allocated_length,
+                                                          initialize);
+    if (data == nullptr) {
+      if (initialize) {
+        data = isolate->array_buffer_allocator()->Allocate(allocated_length);
+      } else {
+        data = isolate->array_buffer_allocator()->AllocateUninitialized(
+            allocated_length);
+      }
     }
     if (data == NULL) {
       isolate->counters()->array_buffer_new_size_failures()->AddSample(
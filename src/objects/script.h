@@ -148,6 +148,10 @@ class Script : public Struct {
 
   bool IsUserJavaScript();
 
+  // Returns true if one of the functions of the script was translated from
+  // asm.js to wasm. Such scripts cannot be put into the code cache.
+  bool ContainsAsmModule();
+
   // Wrappers for GetPositionInfo
   static int GetColumnNumber(Handle<Script> script, int code_offset);
   int GetColumnNumber(int code_pos) const;
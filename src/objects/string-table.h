@@ -5,6 +5,7 @@
 #ifndef V8_OBJECTS_STRING_TABLE_H_
 #define V8_OBJECTS_STRING_TABLE_H_
 
+#include "src/base/platform/mutex.h"
 #include "src/objects/hash-table.h"
 
 // Has to be the last include (doesn't have include guards):
@@ -61,6 +62,19 @@ class StringTable : public HashTable<StringTable, StringTableShape> {
   static Handle<String> LookupKey(Isolate* isolate, StringTableKey* key);
   static String* LookupKeyIfExists(Isolate* isolate, StringTableKey* key);
 
+  // Like FindEntry, but may be called from a background thread. The table is
+  // probed under the heap's relocation mutex, which the GC holds while it
+  // moves or clears entries and the main thread holds while it changes the
+  // table or an internalized string in it (see StringTableWriteScope). The
+  // entry may be stale by the time the main thread uses it and has to be
+  // confirmed with KeyAtEntryIfMatches.
+  static int ConcurrentFindEntry(Heap* heap, StringTableKey* key);
+
+  // Returns the string at {entry} of the current string table if it matches
+  // {key}, or nullptr otherwise.
+  static String* KeyAtEntryIfMatches(Isolate* isolate, StringTableKey* key,
+                                     int entry);
+
   // Looks up a string that is equal to the given string and returns
   // string handle if it is found, or an empty handle otherwise.
   MUST_USE_RESULT static MaybeHandle<String> LookupTwoCharsStringIfExists(
@@ -78,6 +92,21 @@ class StringTable : public HashTable<StringTable, StringTableShape> {
   DISALLOW_IMPLICIT_CONSTRUCTORS(StringTable);
 };
 
+// Serializes main thread writes to the string table, and to the internalized
+// strings in it, with StringTable::ConcurrentFindEntry. Does not lock unless
+// --concurrent-string-table-lookup is on. Must not be held while allocating,
+// because the GC takes the same mutex.
+class StringTableWriteScope {
+ public:
+  explicit StringTableWriteScope(Heap* heap);
+  ~StringTableWriteScope();
+
+ private:
+  base::Mutex* mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(StringTableWriteScope);
+};
+
 class StringSetShape : public BaseShape<String*> {
  public:
   static inline bool IsMatch(String* key, Object* value);
@@ -3377,6 +3377,8 @@ void Parser::ParseOnBackground(ParseInfo* info) {
 
   // We cannot internalize on a background thread; a foreground task will take
   // care of calling AstValueFactory::Internalize just before compilation.
+  // Strings that already exist can still be looked up on the background
+  // thread, see AstValueFactory::LookupConcurrently.
 
   if (produce_cached_parse_data()) {
     if (result != NULL) *info->cached_data() = logger.GetScriptData();
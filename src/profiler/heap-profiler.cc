@@ -10,6 +10,7 @@
 #include "src/profiler/allocation-tracker.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
 #include "src/profiler/sampling-heap-profiler.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -18,7 +19,8 @@ HeapProfiler::HeapProfiler(Heap* heap)
     : ids_(new HeapObjectsMap(heap)),
       names_(new StringsStorage(heap)),
       is_tracking_object_moves_(false),
-      get_retainer_infos_callback_(nullptr) {}
+      get_retainer_infos_callback_(nullptr),
+      streaming_snapshots_count_(0) {}
 
 static void DeleteHeapSnapshot(HeapSnapshot* snapshot_ptr) {
   delete snapshot_ptr;
@@ -26,6 +28,7 @@ static void DeleteHeapSnapshot(HeapSnapshot* snapshot_ptr) {
 
 
 HeapProfiler::~HeapProfiler() {
+  WaitForSnapshotStreaming();
   std::for_each(snapshots_.begin(), snapshots_.end(), &DeleteHeapSnapshot);
 }
 
@@ -33,6 +36,7 @@ HeapProfiler::~HeapProfiler() {
 void HeapProfiler::DeleteAllSnapshots() {
   std::for_each(snapshots_.begin(), snapshots_.end(), &DeleteHeapSnapshot);
   snapshots_.clear();
+  WaitForSnapshotStreaming();
   names_.reset(new StringsStorage(heap()));
 }
 
@@ -74,7 +78,7 @@ v8::HeapProfiler::RetainerInfos HeapProfiler::GetRetainerInfos(
   return infos;
 }
 
-HeapSnapshot* HeapProfiler::TakeSnapshot(
+HeapSnapshot* HeapProfiler::GenerateSnapshot(
     v8::ActivityControl* control,
     v8::HeapProfiler::ObjectNameResolver* resolver) {
   HeapSnapshot* result = new HeapSnapshot(this);
@@ -83,8 +87,6 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
     if (!generator.GenerateSnapshot()) {
       delete result;
       result = NULL;
-    } else {
-      snapshots_.push_back(result);
     }
   }
   ids_->RemoveDeadEntries();
@@ -96,6 +98,70 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+HeapSnapshot* HeapProfiler::TakeSnapshot(
+    v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  HeapSnapshot* result = GenerateSnapshot(control, resolver);
+  if (result != NULL) snapshots_.push_back(result);
+  return result;
+}
+
+class HeapProfiler::SnapshotStreamingTask : public v8::Task {
+ public:
+  SnapshotStreamingTask(HeapProfiler* profiler, HeapSnapshot* snapshot,
+                        v8::OutputStream* stream)
+      : profiler_(profiler),
+        snapshot_(snapshot),
+        serializer_(snapshot),
+        stream_(stream) {
+    serializer_.PrepareForConcurrentSerialization();
+  }
+
+  void Run() override {
+    serializer_.Serialize(stream_);
+    delete snapshot_;
+    base::LockGuard<base::Mutex> guard(&profiler_->streaming_mutex_);
+    profiler_->streaming_snapshots_count_--;
+    profiler_->streaming_done_.NotifyAll();
+  }
+
+ private:
+  HeapProfiler* profiler_;
+  HeapSnapshot* snapshot_;
+  HeapSnapshotJSONSerializer serializer_;
+  v8::OutputStream* stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotStreamingTask);
+};
+
+bool HeapProfiler::TakeSnapshotToStream(
+    v8::OutputStream* stream, v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  // Building the graph is not incremental, so this still pauses the isolate
+  // for as long as TakeSnapshot does.
+  HeapSnapshot* snapshot = GenerateSnapshot(control, resolver);
+  if (snapshot == NULL) return false;
+  // The snapshot graph does not refer to the JS heap, so only the parts of
+  // the serialization that depend on the isolate's profiling state are done
+  // here, by the task's constructor.
+  SnapshotStreamingTask* task = new SnapshotStreamingTask(this, snapshot,
+                                                          stream);
+  {
+    base::LockGuard<base::Mutex> guard(&streaming_mutex_);
+    streaming_snapshots_count_++;
+  }
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kLongRunningTask);
+  return true;
+}
+
+void HeapProfiler::WaitForSnapshotStreaming() {
+  base::LockGuard<base::Mutex> guard(&streaming_mutex_);
+  while (streaming_snapshots_count_ > 0) {
+    streaming_done_.Wait(&streaming_mutex_);
+  }
+}
+
 bool HeapProfiler::StartSamplingHeapProfiler(
     uint64_t sample_interval, int stack_depth,
     v8::HeapProfiler::SamplingFlags flags) {
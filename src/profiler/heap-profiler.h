@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/isolate.h"
 
 namespace v8 {
@@ -29,6 +31,15 @@ class HeapProfiler {
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
 
+  // Takes a snapshot without retaining it and serializes it to |stream| on a
+  // background thread. The graph is built stop-the-world and held in memory
+  // in full until the serialization is done; only the serialization itself
+  // overlaps with the mutator. Returns false if the snapshot could not be
+  // taken.
+  bool TakeSnapshotToStream(v8::OutputStream* stream,
+                            v8::ActivityControl* control,
+                            v8::HeapProfiler::ObjectNameResolver* resolver);
+
   bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
                                  v8::HeapProfiler::SamplingFlags);
   void StopSamplingHeapProfiler();
@@ -81,8 +92,15 @@ class HeapProfiler {
                     v8::PersistentValueVector<v8::Object>* objects);
 
  private:
+  class SnapshotStreamingTask;
+
   Heap* heap() const;
 
+  HeapSnapshot* GenerateSnapshot(
+      v8::ActivityControl* control,
+      v8::HeapProfiler::ObjectNameResolver* resolver);
+  void WaitForSnapshotStreaming();
+
   // Mapping from HeapObject addresses to objects' uids.
   std::unique_ptr<HeapObjectsMap> ids_;
   std::vector<HeapSnapshot*> snapshots_;
@@ -93,6 +111,11 @@ class HeapProfiler {
   base::Mutex profiler_mutex_;
   std::unique_ptr<SamplingHeapProfiler> sampling_heap_profiler_;
   v8::HeapProfiler::GetRetainerInfosCallback get_retainer_infos_callback_;
+  // Number of snapshots that are being serialized on background threads.
+  // They point into names_, which must stay alive until they are done.
+  int streaming_snapshots_count_;
+  base::Mutex streaming_mutex_;
+  base::ConditionVariable streaming_done_;
 
   DISALLOW_COPY_AND_ASSIGN(HeapProfiler);
 };
@@ -2478,10 +2478,33 @@ const int HeapSnapshotJSONSerializer::kEdgeFieldsCount = 3;
 // type, name, id, self_size, edge_count, trace_node_id.
 const int HeapSnapshotJSONSerializer::kNodeFieldsCount = 6;
 
+namespace {
+
+// Collects the output of a serializer in memory.
+class StringOutputStream : public v8::OutputStream {
+ public:
+  explicit StringOutputStream(std::string* contents) : contents_(contents) {}
+  void EndOfStream() override {}
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    contents_->append(data, size);
+    return kContinue;
+  }
+
+ private:
+  std::string* contents_;
+};
+
+}  // namespace
+
 void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
-  if (AllocationTracker* allocation_tracker =
-      snapshot_->profiler()->allocation_tracker()) {
-    allocation_tracker->PrepareForSerialization();
+  if (!prepared_) {
+    AllocationTracker* allocation_tracker =
+        snapshot_->profiler()->allocation_tracker();
+    if (allocation_tracker) {
+      allocation_tracker->PrepareForSerialization();
+      trace_function_count_ = static_cast<uint32_t>(
+          allocation_tracker->function_info_list().size());
+    }
   }
   DCHECK(writer_ == NULL);
   writer_ = new OutputStreamWriter(stream);
@@ -2490,6 +2513,25 @@ void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
   writer_ = NULL;
 }
 
+void HeapSnapshotJSONSerializer::PrepareForConcurrentSerialization() {
+  DCHECK(!prepared_);
+  AllocationTracker* allocation_tracker =
+      snapshot_->profiler()->allocation_tracker();
+  if (allocation_tracker) {
+    allocation_tracker->PrepareForSerialization();
+    trace_function_count_ = static_cast<uint32_t>(
+        allocation_tracker->function_info_list().size());
+  }
+  StringOutputStream stream(&prepared_trace_sections_);
+  DCHECK(writer_ == NULL);
+  writer_ = new OutputStreamWriter(&stream);
+  SerializeTraceSections();
+  writer_->Finalize();
+  delete writer_;
+  writer_ = NULL;
+  prepared_ = true;
+}
+
 
 void HeapSnapshotJSONSerializer::SerializeImpl() {
   DCHECK(0 == snapshot_->root()->index());
@@ -2507,6 +2549,24 @@ void HeapSnapshotJSONSerializer::SerializeImpl() {
   if (writer_->aborted()) return;
   writer_->AddString("],\n");
 
+  if (prepared_) {
+    writer_->AddSubstring(prepared_trace_sections_.c_str(),
+                          static_cast<int>(prepared_trace_sections_.size()));
+  } else {
+    SerializeTraceSections();
+  }
+  if (writer_->aborted()) return;
+
+  writer_->AddString("\"strings\":[");
+  SerializeStrings();
+  if (writer_->aborted()) return;
+  writer_->AddCharacter(']');
+  writer_->AddCharacter('}');
+  writer_->Finalize();
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeTraceSections() {
   writer_->AddString("\"trace_function_infos\":[");
   SerializeTraceNodeInfos();
   if (writer_->aborted()) return;
@@ -2520,13 +2580,6 @@ void HeapSnapshotJSONSerializer::SerializeImpl() {
   SerializeSamples();
   if (writer_->aborted()) return;
   writer_->AddString("],\n");
-
-  writer_->AddString("\"strings\":[");
-  SerializeStrings();
-  if (writer_->aborted()) return;
-  writer_->AddCharacter(']');
-  writer_->AddCharacter('}');
-  writer_->Finalize();
 }
 
 
@@ -2728,12 +2781,7 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
   writer_->AddString(",\"edge_count\":");
   writer_->AddNumber(static_cast<double>(snapshot_->edges().size()));
   writer_->AddString(",\"trace_function_count\":");
-  uint32_t count = 0;
-  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
-  if (tracker) {
-    count = static_cast<uint32_t>(tracker->function_info_list().size());
-  }
-  writer_->AddNumber(count);
+  writer_->AddNumber(trace_function_count_);
 }
 
 
@@ -6,6 +6,7 @@
 #define V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
 
 #include <deque>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -572,10 +573,17 @@ class HeapSnapshotJSONSerializer {
         strings_(StringsMatch),
         next_node_id_(1),
         next_string_id_(1),
+        trace_function_count_(0),
+        prepared_(false),
         writer_(NULL) {
   }
   void Serialize(v8::OutputStream* stream);
 
+  // Serializes the parts that depend on the allocation tracker and on the
+  // heap object id samples, which the isolate keeps updating. Afterwards,
+  // Serialize only reads the snapshot itself and may run on another thread.
+  void PrepareForConcurrentSerialization();
+
  private:
   INLINE(static bool StringsMatch(void* key1, void* key2)) {
     return strcmp(reinterpret_cast<char*>(key1),
@@ -597,6 +605,7 @@ class HeapSnapshotJSONSerializer {
   void SerializeNode(const HeapEntry* entry);
   void SerializeNodes();
   void SerializeSnapshot();
+  void SerializeTraceSections();
   void SerializeTraceTree();
   void SerializeTraceNode(AllocationTraceNode* node);
   void SerializeTraceNodeInfos();
@@ -611,6 +620,10 @@ class HeapSnapshotJSONSerializer {
   base::CustomMatcherHashMap strings_;
   int next_node_id_;
   int next_string_id_;
+  uint32_t trace_function_count_;
+  // Set by PrepareForConcurrentSerialization.
+  bool prepared_;
+  std::string prepared_trace_sections_;
   OutputStreamWriter* writer_;
 
   friend class HeapSnapshotJSONSerializerEnumerator;
@@ -22,6 +22,10 @@ namespace internal {
 // optimized.
 static const int kProfilerTicksBeforeOptimization = 2;
 
+// Number of times a function that was optimized before, and did not
+// deoptimize since, has to be seen on the stack before it is optimized again.
+static const int kProfilerTicksBeforeReoptimization = 1;
+
 // The number of ticks required for optimizing a function increases with
 // the size of the bytecode. This is in addition to the
 // kProfilerTicksBeforeOptimization required for any function.
@@ -42,6 +46,7 @@ static const int kMaxBytecodeSizeForOpt = 60 * KB;
 #define OPTIMIZATION_REASON_LIST(V)                            \
   V(DoNotOptimize, "do not optimize")                          \
   V(HotAndStable, "hot and stable")                            \
+  V(PreviouslyOptimized, "previously optimized")               \
   V(SmallFunction, "small function")
 
 enum class OptimizationReason : uint8_t {
@@ -211,6 +216,12 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction* function,
       (shared->bytecode_array()->length() / kBytecodeSizeAllowancePerTick);
   if (ticks >= ticks_for_optimization) {
     return OptimizationReason::kHotAndStable;
+  } else if (FLAG_reoptimize_previously_optimized &&
+             shared->was_optimized() &&
+             ticks >= kProfilerTicksBeforeReoptimization) {
+    // The function was hot before, possibly in the process that created the
+    // code cache it was deserialized from.
+    return OptimizationReason::kPreviouslyOptimized;
   } else if (!any_ic_changed_ &&
              shared->bytecode_array()->length() < kMaxBytecodeSizeForEarlyOpt) {
     // If no IC was patched since the last tick and this function is very
@@ -111,6 +111,12 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   if (obj->IsScript()) {
     // Wrapper object is a context-dependent JSValue. Reset it here.
     Script::cast(obj)->set_wrapper(isolate()->heap()->undefined_value());
+  } else if (obj->IsBytecodeArray()) {
+    // A script that already ran may have a stack frame cache, which is a hash
+    // table. Drop it, it is recomputed on demand.
+    BytecodeArray* bytecode_array = BytecodeArray::cast(obj);
+    bytecode_array->set_source_position_table(
+        bytecode_array->SourcePositionTable());
   }
 
   // Past this point we should not see any (context-specific) maps anymore.
@@ -764,6 +764,8 @@
         'compiler/js-generic-lowering.h',
         'compiler/js-graph.cc',
         'compiler/js-graph.h',
+        'compiler/js-heap-broker.cc',
+        'compiler/js-heap-broker.h',
         'compiler/js-inlining.cc',
         'compiler/js-inlining.h',
         'compiler/js-inlining-heuristic.cc',
@@ -963,6 +965,8 @@
         'factory.h',
         'fast-dtoa.cc',
         'fast-dtoa.h',
+        'feedback-profile.cc',
+        'feedback-profile.h',
         'feedback-vector-inl.h',
         'feedback-vector.cc',
         'feedback-vector.h',
@@ -992,6 +996,8 @@
         'handles.cc',
         'handles.h',
         'heap-symbols.h',
+        'heap/array-buffer-pool.cc',
+        'heap/array-buffer-pool.h',
         'heap/array-buffer-tracker-inl.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
@@ -1006,9 +1012,15 @@
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
         'heap/gc-idle-time-handler.h',
+        'heap/gc-latency-scheduler.cc',
+        'heap/gc-latency-scheduler.h',
         'heap/gc-tracer.cc',
         'heap/gc-tracer.h',
         'heap/heap-inl.h',
+        'heap/heap-memory-budget.cc',
+        'heap/heap-memory-budget.h',
+        'heap/heap-statistics-recorder.cc',
+        'heap/heap-statistics-recorder.h',
         'heap/heap.cc',
         'heap/heap.h',
         'heap/incremental-marking-inl.h',
@@ -46,6 +46,7 @@
       'compiler/test-gap-resolver.cc',
       'compiler/test-graph-visualizer.cc',
       'compiler/test-code-generator.cc',
+      'compiler/test-concurrent-typed-lowering.cc',
       'compiler/test-code-assembler.cc',
       'compiler/test-instruction.cc',
       'compiler/test-js-context-specialization.cc',
@@ -0,0 +1,57 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/api.h"
+#include "src/flags.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Runs the typer and the typed lowering on the concurrent recompilation
+// thread. Calls to known functions are typed and lowered from the data that
+// the JSHeapBroker recorded on the main thread.
+TEST(ConcurrentTypedLoweringOfKnownCalls) {
+  FLAG_allow_natives_syntax = true;
+  FLAG_concurrent_recompilation = true;
+  FLAG_concurrent_typed_lowering = true;
+  FLAG_block_concurrent_recompilation = false;
+  // Keep the calls in the graph until the typed lowering.
+  FLAG_turbo_inlining = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  if (!isolate->use_optimizer() ||
+      !isolate->concurrent_recompilation_enabled()) {
+    return;
+  }
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Context> context = CcTest::isolate()->GetCurrentContext();
+
+  CompileRun(
+      "function callee(a, b) { return a + (b | 0); }"
+      "function Point(x) { this.x = x; }"
+      "function f(x) {"
+      "  return callee(x, 1) + callee(x) + Math.floor(x + 0.5) +"
+      "         new Point(x).x;"
+      "}"
+      "f(1); f(2);"
+      "%OptimizeFunctionOnNextCall(f, 'concurrent');"
+      "f(3);"
+      // Blocks until the job is done and the code is installed.
+      "%GetOptimizationStatus(f);");
+
+  Handle<JSFunction> f = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(
+          CcTest::global()->Get(context, v8_str("f")).ToLocalChecked())));
+  CHECK(f->IsOptimized());
+  CHECK_EQ(17, CompileRun("f(4)")->Int32Value(context).FromJust());
+  CHECK(f->IsOptimized());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/api.h"
+#include "src/heap/array-buffer-pool.h"
 #include "src/heap/array-buffer-tracker.h"
 #include "src/heap/spaces.h"
 #include "src/isolate.h"
@@ -372,6 +373,42 @@ TEST(ArrayBuffer_RetainedSizeDecreases) {
   CHECK_EQ(0, retained_after - retained_before);
 }
 
+UNINITIALIZED_TEST(ArrayBuffer_PooledBackingStoreIsReusedAndZeroed) {
+  ManualGCScope manual_gc_scope;
+  FLAG_array_buffer_pool_size = 64;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Heap* heap = i_isolate->heap();
+    ArrayBufferPool* pool = heap->array_buffer_pool();
+    const size_t kLength = ArrayBufferPool::kSizeClassStep;
+
+    void* backing_store = nullptr;
+    {
+      v8::HandleScope inner_scope(isolate);
+      Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, kLength);
+      Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+      backing_store = buf->backing_store();
+      memset(backing_store, 0xff, kLength);
+    }
+    heap::GcAndSweep(heap, NEW_SPACE);
+    CHECK_EQ(kLength, pool->pooled_bytes());
+
+    Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, kLength);
+    Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+    CHECK_EQ(backing_store, buf->backing_store());
+    CHECK_EQ(0u, pool->pooled_bytes());
+    uint8_t* data = reinterpret_cast<uint8_t*>(buf->backing_store());
+    for (size_t i = 0; i < kLength; i++) CHECK_EQ(0, data[i]);
+  }
+  isolate->Dispose();
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -2,7 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <set>
+
 #include "src/factory.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/mark-compact.h"
 #include "src/isolate.h"
 // FIXME(mstarzinger, marja): This is weird, but required because of the missing
@@ -375,6 +378,84 @@ HEAP_TEST(CompactionPartiallyAbortedPageWithStoreBufferEntries) {
   }
 }
 
+namespace {
+
+int CountPagesOfElements(Handle<FixedArray> holder) {
+  std::set<Page*> pages;
+  for (int i = 0; i < holder->length(); i++) {
+    pages.insert(
+        Page::FromAddress(HeapObject::cast(holder->get(i))->address()));
+  }
+  return static_cast<int>(pages.size());
+}
+
+void CollectGarbageWithSlowCompactionSpeed(Heap* heap) {
+  // Pretend that evacuating a whole area takes a second, so that a budget of
+  // 1ms falls back to the minimum of a single area.
+  for (int i = 0; i < base::RingBuffer<double>::kSize; i++) {
+    heap->tracer()->AddCompactionEvent(1000, Page::kAllocatableMemory);
+  }
+  heap->CollectAllGarbage(Heap::kReduceMemoryFootprintMask,
+                          GarbageCollectionReason::kTesting);
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+}
+
+}  // namespace
+
+TEST(CompactionTimeBudgetLimitsCandidates) {
+  if (FLAG_never_compact || FLAG_always_compact || FLAG_stress_compaction) {
+    return;
+  }
+  FLAG_concurrent_sweeping = false;
+  FLAG_concurrent_marking = false;
+  FLAG_stress_incremental_marking = false;
+  FLAG_compaction_time_budget = 1;
+
+  // Each page keeps 30% of its arrays alive. Without a budget all pages are
+  // merged into ceil(kPages * 0.3) pages by a single memory reducing GC.
+  const int kPages = 8;
+  const int kArraysPerPage = Page::kAllocatableMemory / 128;
+  const int kLiveArraysPerPage = kArraysPerPage * 3 / 10;
+
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  {
+    HandleScope scope1(isolate);
+    Handle<FixedArray> holder = isolate->factory()->NewFixedArray(
+        kPages * kLiveArraysPerPage, TENURED);
+    heap::SealCurrentObjects(heap);
+
+    int index = 0;
+    for (int page = 0; page < kPages; page++) {
+      HandleScope scope2(isolate);
+      std::vector<Handle<FixedArray>> arrays =
+          heap::FillOldSpacePageWithFixedArrays(heap, 0);
+      CHECK_EQ(kArraysPerPage, static_cast<int>(arrays.size()));
+      for (int i = 0; i < kLiveArraysPerPage; i++) {
+        holder->set(index++, *arrays[i * 10 / 3]);
+      }
+    }
+    heap->old_space()->EmptyAllocationInfo();
+
+    // Sweep the filled pages so that their allocated bytes only account for
+    // the arrays kept alive by {holder}.
+    CollectGarbageWithSlowCompactionSpeed(heap);
+    CHECK_EQ(kPages, CountPagesOfElements(holder));
+
+    // The budget admits only the three sparsest pages, i.e., the first GC
+    // stops early but still releases pages.
+    CollectGarbageWithSlowCompactionSpeed(heap);
+    const int pages_after_first_gc = CountPagesOfElements(holder);
+    CHECK_LT(pages_after_first_gc, kPages);
+    CHECK_GT(pages_after_first_gc, (kPages * 3 + 9) / 10);
+
+    // Pages left behind are picked up by the next GC.
+    CollectGarbageWithSlowCompactionSpeed(heap);
+    CHECK_LT(CountPagesOfElements(holder), pages_after_first_gc);
+  }
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
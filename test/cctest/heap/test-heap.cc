@@ -917,6 +917,102 @@ TEST(StringTable) {
 }
 
 
+TEST(StringDeduplication) {
+  FLAG_string_deduplication = true;
+  FLAG_never_compact = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  ManualGCScope manual_gc_scope;
+
+  v8::HandleScope sc(CcTest::isolate());
+  const char* contents = "a string long enough to be deduplicated";
+  Handle<String> a = factory->NewStringFromAsciiChecked(contents, TENURED);
+  Handle<String> b = factory->NewStringFromAsciiChecked(contents, TENURED);
+  const char* other_contents = "another string that is not internalized";
+  Handle<String> c =
+      factory->NewStringFromAsciiChecked(other_contents, TENURED);
+  CHECK_NE(*a, *b);
+  CHECK(!a->IsInternalizedString());
+  CHECK(!b->IsInternalizedString());
+  Handle<String> internalized = factory->InternalizeUtf8String(contents);
+  CHECK_NE(*internalized, *a);
+  CHECK_NE(*internalized, *b);
+
+  CcTest::CollectAllGarbage();
+
+  // Both copies now forward to the internalized string.
+  CHECK(a->IsThinString());
+  CHECK(b->IsThinString());
+  CHECK_EQ(*internalized, ThinString::cast(*a)->actual());
+  CHECK_EQ(*internalized, ThinString::cast(*b)->actual());
+  // A single string without an internalized counterpart is left alone.
+  CHECK(c->IsSeqString());
+  CHECK(!c->IsInternalizedString());
+}
+
+TEST(StringDeduplicationOfUninternalizedCopies) {
+  FLAG_string_deduplication = true;
+  FLAG_never_compact = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  ManualGCScope manual_gc_scope;
+
+  v8::HandleScope sc(CcTest::isolate());
+  // Like values of parsed JSON, none of these copies is internalized.
+  const char* contents = "a JSON value that occurs several times";
+  Handle<String> a = factory->NewStringFromAsciiChecked(contents, TENURED);
+  Handle<String> b = factory->NewStringFromAsciiChecked(contents, TENURED);
+  Handle<String> c = factory->NewStringFromAsciiChecked(contents, TENURED);
+
+  CcTest::CollectAllGarbage();
+
+  // One copy is internalized in place and the others forward to it.
+  Handle<String> internalized = factory->InternalizeUtf8String(contents);
+  int in_place = 0;
+  for (Handle<String> copy : {a, b, c}) {
+    if (copy->IsInternalizedString()) {
+      CHECK_EQ(*internalized, *copy);
+      in_place++;
+    } else {
+      CHECK(copy->IsThinString());
+      CHECK_EQ(*internalized, ThinString::cast(*copy)->actual());
+    }
+  }
+  CHECK_EQ(1, in_place);
+}
+
+TEST(StringDeduplicationMaxCandidates) {
+  FLAG_string_deduplication = true;
+  FLAG_string_deduplication_max_candidates = 1;
+  FLAG_never_compact = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  ManualGCScope manual_gc_scope;
+
+  v8::HandleScope sc(CcTest::isolate());
+  const char* contents = "a string long enough to be deduplicated";
+  Handle<String> a = factory->NewStringFromAsciiChecked(contents, TENURED);
+  Handle<String> b = factory->NewStringFromAsciiChecked(contents, TENURED);
+  factory->InternalizeUtf8String(contents);
+
+  CcTest::CollectAllGarbage();
+
+  // At most one candidate is considered per GC.
+  CHECK(!a->IsThinString() || !b->IsThinString());
+
+  // Later GCs pick up where the previous one stopped, so both copies are
+  // eventually deduplicated.
+  for (int i = 0; i < 100 && !(a->IsThinString() && b->IsThinString()); i++) {
+    CcTest::CollectAllGarbage();
+  }
+  CHECK(a->IsThinString());
+  CHECK(b->IsThinString());
+}
+
+
 TEST(FunctionAllocation) {
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
@@ -2712,6 +2808,44 @@ TEST(Regress1465) {
 }
 
 
+TEST(ParallelMapClearing) {
+  FLAG_stress_compaction = false;
+  FLAG_stress_incremental_marking = false;
+  FLAG_retain_maps_for_n_gc = 0;
+  FLAG_parallel_map_clearing = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Context> ctx = CcTest::isolate()->GetCurrentContext();
+  static const int kParents = 2048;
+
+  // Every constructor gets a parent map {a} with the transitions {a, b} and
+  // {a, c}. The first one owns the descriptors of the parent and dies.
+  CompileRun(
+      "function Make() { return function() {}; }"
+      "var live = [];"
+      "for (var i = 0; i < 2048; i++) {"
+      "  var F = Make();"
+      "  var dead = new F; dead.a = 1; dead.b = 2;"
+      "  var o = new F; o.a = 1; o.c = 3;"
+      "  live.push(o);"
+      "}"
+      "dead = o = undefined;");
+  CcTest::CollectAllGarbage();
+
+  Handle<JSArray> live = Handle<JSArray>::cast(v8::Utils::OpenHandle(
+      *v8::Local<v8::Object>::Cast(
+          CcTest::global()->Get(ctx, v8_str("live")).ToLocalChecked())));
+  FixedArray* elements = FixedArray::cast(live->elements());
+  for (int i = 0; i < kParents; i++) {
+    Map* map = JSObject::cast(elements->get(i))->map();
+    Map* parent = Map::cast(map->GetBackPointer());
+    CHECK_EQ(1, CountMapTransitions(parent));
+    CHECK(parent->owns_descriptors());
+    CHECK_EQ(1, parent->instance_descriptors()->number_of_descriptors());
+  }
+}
+
+
 #ifdef DEBUG
 static void AddTransitions(int transitions_count) {
   AlwaysAllocateScope always_allocate(CcTest::i_isolate());
@@ -5981,6 +6115,156 @@ UNINITIALIZED_TEST(ReinitializeStringHashSeed) {
   }
 }
 
+namespace {
+
+class RecordingHeapStatisticsStream : public v8::HeapStatisticsStream {
+ public:
+  void WriteRecord(const uint8_t* data, size_t size) override {
+    records_.push_back(std::vector<uint8_t>(data, data + size));
+  }
+
+  const std::vector<std::vector<uint8_t>>& records() const { return records_; }
+
+ private:
+  std::vector<std::vector<uint8_t>> records_;
+};
+
+uint64_t ReadVarint(const std::vector<uint8_t>& record, size_t* pos) {
+  uint64_t value = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    CHECK_LT(*pos, record.size());
+    byte = record[(*pos)++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+}  // namespace
+
+TEST(HeapStatisticsStream) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  RecordingHeapStatisticsStream stream;
+  isolate->SetHeapStatisticsStream(&stream, 4);
+
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK_EQ(0, stream.records().size());
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(1, stream.records().size());
+
+  const std::vector<uint8_t>& record = stream.records()[0];
+  size_t pos = 0;
+  CHECK_EQ(1, ReadVarint(record, &pos));
+  CHECK_EQ(CcTest::heap()->gc_count(), ReadVarint(record, &pos));
+  uint64_t type_count = ReadVarint(record, &pos);
+  CHECK_GT(type_count, 0);
+  bool found_map_type = false;
+  for (uint64_t i = 0; i < type_count; i++) {
+    uint64_t type = ReadVarint(record, &pos);
+    CHECK_NOT_NULL(isolate->GetHeapObjectTypeName(type));
+    uint64_t count = ReadVarint(record, &pos);
+    uint64_t bytes = ReadVarint(record, &pos);
+    CHECK_GT(count, 0);
+    CHECK_GE(bytes, count * kPointerSize);
+    if (type == MAP_TYPE) found_map_type = true;
+  }
+  CHECK(found_map_type);
+  uint64_t site_count = ReadVarint(record, &pos);
+  CHECK_LE(site_count, 4);
+  for (uint64_t i = 0; i < 3 * site_count; i++) ReadVarint(record, &pos);
+  CHECK_EQ(LAST_SPACE - FIRST_SPACE + 1, ReadVarint(record, &pos));
+  for (int space = FIRST_SPACE; space <= LAST_SPACE; space++) {
+    CHECK_EQ(space, ReadVarint(record, &pos));
+    uint64_t committed = ReadVarint(record, &pos);
+    uint64_t used = ReadVarint(record, &pos);
+    ReadVarint(record, &pos);
+    CHECK_LE(used, committed);
+  }
+  CHECK_EQ(record.size(), pos);
+
+  isolate->SetHeapStatisticsStream(nullptr);
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(1, stream.records().size());
+}
+
+static int heap_memory_budget_callback_count = 0;
+
+static void HeapMemoryBudgetCallback(v8::Isolate* isolate, size_t used_bytes,
+                                     size_t budget_bytes, void* data) {
+  CHECK_GT(used_bytes, budget_bytes);
+  heap_memory_budget_callback_count++;
+}
+
+TEST(HeapMemoryBudget) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  v8::HandleScope scope(isolate);
+  heap_memory_budget_callback_count = 0;
+
+  // Any heap exceeds a budget of 1 KB.
+  isolate->SetHeapMemoryBudget(1 * KB, HeapMemoryBudgetCallback);
+  CcTest::CollectAllGarbage();
+  CHECK(isolate->IsHeapMemoryBudgetExceeded());
+  // The stages are applied on the next interrupt.
+  CHECK_EQ(0, heap_memory_budget_callback_count);
+  i_isolate->stack_guard()->HandleInterrupts();
+  CHECK_EQ(1, heap_memory_budget_callback_count);
+
+  // The stages are applied only once while the heap stays above the budget.
+  CcTest::CollectAllGarbage();
+  i_isolate->stack_guard()->HandleInterrupts();
+  CHECK_EQ(1, heap_memory_budget_callback_count);
+
+  isolate->SetHeapMemoryBudget(0);
+  CHECK(!isolate->IsHeapMemoryBudgetExceeded());
+  CcTest::CollectAllGarbage();
+  CHECK(!isolate->IsHeapMemoryBudgetExceeded());
+}
+
+TEST(YoungLargeObjects) {
+  if (FLAG_minor_mc) return;
+  FLAG_young_generation_large_objects = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Isolate* isolate = heap->isolate();
+  const int kLength = 100000;
+  CHECK_GT(FixedArray::SizeFor(kLength), kMaxRegularHeapObjectSize);
+
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(kLength);
+  CHECK(heap->new_lo_space()->Contains(*array));
+  CHECK(heap->InNewSpace(*array));
+  Address address = array->address();
+  Handle<FixedArray> element = isolate->factory()->NewFixedArray(10);
+  array->set(0, *element);
+
+  Address dead_address;
+  {
+    HandleScope inner_scope(isolate);
+    Handle<FixedArray> dead = isolate->factory()->NewFixedArray(kLength);
+    CHECK(heap->new_lo_space()->Contains(*dead));
+    dead_address = dead->address();
+  }
+
+  // Surviving objects are promoted in place, dead ones are freed.
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK_EQ(address, array->address());
+  CHECK(!heap->InNewSpace(*array));
+  CHECK(!heap->new_lo_space()->ContainsSlow(dead_address));
+  CHECK(!heap->lo_space()->ContainsSlow(dead_address));
+
+  // The young element is found through the remembered set of the page.
+  CcTest::CollectGarbage(NEW_SPACE);
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK_EQ(*element, array->get(0));
+  CHECK_EQ(10, FixedArray::cast(array->get(0))->length());
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -120,6 +120,39 @@ UNINITIALIZED_TEST(PagePromotion_NewToNew) {
   isolate->Dispose();
 }
 
+UNINITIALIZED_TEST(PagePromotion_MinorMCPromoteInPlace) {
+  if (!i::FLAG_page_promotion) return;
+
+  v8::Isolate* isolate = NewIsolateForPagePromotion();
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  FLAG_minor_mc = true;
+  FLAG_minor_mc_promote_in_place = true;
+  // No page can reach this threshold, i.e., without in-place promotion all
+  // survivors would be copied.
+  FLAG_page_promotion_threshold = 100;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Heap* heap = i_isolate->heap();
+
+    std::vector<Handle<FixedArray>> handles;
+    heap::SimulateFullSpace(heap->new_space(), &handles);
+    CHECK_GT(handles.size(), 0u);
+    Handle<FixedArray> survivor = handles.back();
+    Page* to_be_promoted_page = Page::FromAddress(survivor->address());
+    CHECK(!to_be_promoted_page->Contains(heap->new_space()->age_mark()));
+    Address survivor_address = survivor->address();
+    heap->CollectGarbage(NEW_SPACE, i::GarbageCollectionReason::kTesting);
+    // The object survived without being copied.
+    CHECK_EQ(survivor_address, survivor->address());
+    CHECK(heap->new_space()->ToSpaceContainsSlow(survivor->address()));
+  }
+  isolate->Dispose();
+  FLAG_minor_mc_promote_in_place = false;
+  FLAG_minor_mc = false;
+}
+
 UNINITIALIZED_TEST(PagePromotion_NewToNewJSArrayBuffer) {
   if (!i::FLAG_page_promotion) return;
 
@@ -286,6 +286,42 @@ TEST(MemoryAllocator) {
 }
 
 
+#ifdef V8_COMPRESS_POINTERS
+TEST(PtrComprCage) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  // Every page handed out by the heap lives in the cage.
+  PtrComprCage* heap_cage = heap->memory_allocator()->ptr_compr_cage();
+  CHECK(heap_cage->valid());
+  CHECK(IsAddressAligned(heap_cage->base(), kPtrComprCageBaseAlignment));
+  for (Page* p : *heap->old_space()) {
+    CHECK(heap_cage->contains(p->address()));
+  }
+
+  PtrComprCage* cage = new PtrComprCage(isolate);
+  CHECK(cage->SetUp());
+  CHECK(IsAddressAligned(cage->base(), kPtrComprCageBaseAlignment));
+
+  size_t allocated = 0;
+  Address first = cage->AllocateRawMemory(Page::kPageSize + 1, Page::kPageSize,
+                                          &allocated);
+  CHECK_NOT_NULL(first);
+  CHECK_EQ(2 * static_cast<size_t>(MemoryChunk::kAlignment), allocated);
+  CHECK(cage->contains(first));
+  CHECK(IsAddressAligned(first, MemoryChunk::kAlignment));
+
+  Address second =
+      cage->AllocateRawMemory(Page::kPageSize, Page::kPageSize, &allocated);
+  CHECK_NOT_NULL(second);
+  CHECK(second >= first + 2 * MemoryChunk::kAlignment);
+
+  cage->FreeRawMemory(first, 2 * MemoryChunk::kAlignment);
+  cage->FreeRawMemory(second, MemoryChunk::kAlignment);
+  delete cage;
+}
+#endif  // V8_COMPRESS_POINTERS
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
@@ -370,6 +406,22 @@ TEST(LargeObjectSpace) {
   CHECK(lo->AllocateRaw(lo_size, NOT_EXECUTABLE).IsRetry());
 }
 
+#ifndef V8_COMPRESS_POINTERS
+TEST(LargeObjectSpaceHugePageAlignment) {
+  FLAG_transparent_huge_pages = true;
+  FLAG_incremental_marking = false;
+  CcTest::InitializeVM();
+
+  LargeObjectSpace* lo = CcTest::heap()->lo_space();
+  int lo_size = static_cast<int>(MemoryAllocator::kHugePageSize);
+  Object* obj = lo->AllocateRaw(lo_size, NOT_EXECUTABLE).ToObjectChecked();
+  MemoryChunk* chunk =
+      MemoryChunk::FromAddress(HeapObject::cast(obj)->address());
+  CHECK(IsAligned(reinterpret_cast<intptr_t>(chunk->address()),
+                  MemoryAllocator::kHugePageSize));
+}
+#endif  // V8_COMPRESS_POINTERS
+
 #ifndef DEBUG
 // The test verifies that committed size of a space is less then some threshold.
 // Debug builds pull in all sorts of additional instrumentation that increases
@@ -631,6 +631,74 @@ TEST(StoreOwnIC) {
   CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
 }
 
+TEST(FeedbackCache) {
+  if (i::FLAG_always_opt) return;
+
+  const char* source = "function f(a, b) { return a + b; }";
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptCompiler::Source source(source_str);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CompileRun("f(1.5, 2);");
+    cache = v8::ScriptCompiler::CreateFeedbackCache(script, source_str);
+    CHECK_NOT_NULL(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptCompiler::Source source(source_str);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate2, &source)
+            .ToLocalChecked();
+    v8::ScriptCompiler::ConsumeFeedbackCache(script, source_str, cache);
+    CHECK(!cache->rejected);
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CompileRun("f(1, 2);");
+
+    // The vector of f starts out with the feedback of the first isolate.
+    Handle<JSFunction> f = Handle<JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("f")));
+    Handle<FeedbackVector> feedback_vector(f->feedback_vector());
+    FeedbackVectorHelper helper(feedback_vector);
+    CHECK_EQ(1, helper.slot_count());
+    CHECK_SLOT_KIND(helper, 0, FeedbackSlotKind::kBinaryOp);
+    BinaryOpICNexus nexus(feedback_vector, helper.slot(0));
+    CHECK_EQ(BinaryOperationHint::kNumber, nexus.GetBinaryOperationFeedback());
+    CHECK_EQ(2, feedback_vector->invocation_count());
+
+    // A cache for another source is rejected.
+    v8::Local<v8::String> other_str = v8_str("function f(a, b) { }");
+    v8::ScriptCompiler::Source other(other_str);
+    v8::Local<v8::UnboundScript> other_script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate2, &other)
+            .ToLocalChecked();
+    v8::ScriptCompiler::ConsumeFeedbackCache(other_script, other_str, cache);
+    CHECK(cache->rejected);
+  }
+  isolate2->Dispose();
+  delete cache;
+}
+
 }  // namespace
 
 }  // namespace internal
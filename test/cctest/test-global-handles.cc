@@ -185,5 +185,95 @@ TEST(PhatomHandlesWithoutCallbacks) {
   CHECK_EQ(0u, isolate->NumberOfPhantomHandleResetsSinceLastCall());
 }
 
+static int batched_weak_callback_invocations = 0;
+static size_t batched_weak_callback_handles = 0;
+
+void BatchedWeakCallback(v8::Isolate* isolate, void* const* parameters,
+                         size_t count, void* data) {
+  batched_weak_callback_invocations++;
+  batched_weak_callback_handles += count;
+  for (size_t i = 0; i < count; i++) {
+    static_cast<v8::Global<v8::Object>*>(parameters[i])->Reset();
+  }
+}
+
+TEST(BatchedWeakCallback) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  isolate->SetBatchedWeakCallback(BatchedWeakCallback);
+
+  // Enough handles to identify the weak handles in parallel.
+  const size_t kHandles = 32 * 1024;
+  std::vector<v8::Global<v8::Object>> globals(kHandles);
+  v8::Global<v8::Object> strong;
+  {
+    v8::HandleScope scope(isolate);
+    for (size_t i = 0; i < kHandles; i++) {
+      globals[i].Reset(isolate, v8::Object::New(isolate));
+      globals[i].SetWeakBatched(&globals[i]);
+    }
+    // A batched handle to a live object is not released.
+    strong.Reset(isolate, v8::Local<v8::Object>::New(isolate, globals[0]));
+  }
+
+  CcTest::CollectAllAvailableGarbage();
+  CHECK_EQ(1, batched_weak_callback_invocations);
+  CHECK_EQ(kHandles - 1, batched_weak_callback_handles);
+  CHECK(!globals[0].IsEmpty());
+  for (size_t i = 1; i < kHandles; i++) CHECK(globals[i].IsEmpty());
+
+  globals[0].Reset();
+  strong.Reset();
+}
+
+static std::vector<void*> batched_weak_parameters;
+
+void DeferringBatchedWeakCallback(v8::Isolate* isolate,
+                                  void* const* parameters, size_t count,
+                                  void* data) {
+  batched_weak_parameters.insert(batched_weak_parameters.end(), parameters,
+                                 parameters + count);
+}
+
+TEST(BatchedWeakHandlesResetAfterGC) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  GlobalHandles* global_handles = CcTest::i_isolate()->global_handles();
+  // The handles of dead objects stay allocated until the embedder resets
+  // them, which may be after the callback returned.
+  isolate->SetBatchedWeakCallback(DeferringBatchedWeakCallback);
+
+  const int initial_handles = global_handles->global_handles_count();
+  const size_t kHandles = 16;
+  std::vector<v8::Global<v8::Object>> globals(kHandles);
+  {
+    v8::HandleScope scope(isolate);
+    for (size_t i = 0; i < kHandles; i++) {
+      globals[i].Reset(isolate, v8::Object::New(isolate));
+      globals[i].SetWeakBatched(&globals[i]);
+    }
+  }
+
+  CcTest::CollectAllAvailableGarbage();
+  CHECK_EQ(kHandles, batched_weak_parameters.size());
+  CHECK_EQ(initial_handles + static_cast<int>(kHandles),
+           global_handles->global_handles_count());
+
+  // New handles do not reuse the nodes of the dead objects' handles.
+  v8::Global<v8::Object> other;
+  {
+    v8::HandleScope scope(isolate);
+    other.Reset(isolate, v8::Object::New(isolate));
+  }
+  for (size_t i = 0; i < kHandles; i++) {
+    CHECK(!globals[i].IsEmpty());
+    globals[i].Reset();
+  }
+  CHECK_EQ(initial_handles + 1, global_handles->global_handles_count());
+  CHECK(!other.IsEmpty());
+  other.Reset();
+  CHECK_EQ(initial_handles, global_handles->global_handles_count());
+}
+
 }  // namespace internal
 }  // namespace v8
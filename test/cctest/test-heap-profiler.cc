@@ -36,6 +36,7 @@
 #include "include/v8-profiler.h"
 #include "src/api.h"
 #include "src/base/hashmap.h"
+#include "src/base/platform/semaphore.h"
 #include "src/collector.h"
 #include "src/debug/debug.h"
 #include "src/objects-inl.h"
@@ -1043,6 +1044,54 @@ TEST(HeapSnapshotJSONSerializationAborting) {
 
 namespace {
 
+class BackgroundJSONStream : public TestJSONStream {
+ public:
+  BackgroundJSONStream() : done_(0) {}
+  void EndOfStream() override {
+    TestJSONStream::EndOfStream();
+    done_.Signal();
+  }
+  void WaitForEndOfStream() { done_.Wait(); }
+
+ private:
+  v8::base::Semaphore done_;
+};
+
+}  // namespace
+
+TEST(HeapSnapshotStreamedJSONSerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun("var a = { s: 'streamed' };");
+
+  BackgroundJSONStream stream;
+  CHECK(heap_profiler->TakeHeapSnapshotToStream(&stream));
+  // The streamed snapshot is not retained.
+  CHECK_EQ(0, heap_profiler->GetSnapshotCount());
+  stream.WaitForEndOfStream();
+  CHECK_EQ(1, stream.eos_signaled());
+  CHECK_GT(stream.size(), 0);
+
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternalOneByte(env->GetIsolate(), json_res)
+          .ToLocalChecked();
+  env->Global()
+      ->Set(env.local(), v8_str("streamed_snapshot"), json_string)
+      .FromJust();
+  v8::Local<v8::Value> result = CompileRun(
+      "var parsed = JSON.parse(streamed_snapshot);\n"
+      "parsed.nodes.length / parsed.snapshot.meta.node_fields.length ==\n"
+      "    parsed.snapshot.node_count &&\n"
+      "parsed.strings.indexOf('streamed') != -1;");
+  CHECK(result->IsTrue());
+}
+
+namespace {
+
 class TestStatsStream : public v8::OutputStream {
  public:
   TestStatsStream()
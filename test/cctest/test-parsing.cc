@@ -10405,3 +10405,109 @@ TEST(LexicalLoopVariable) {
     });
   }
 }
+
+TEST(AstValueFactoryConcurrentLookup) {
+  i::FLAG_concurrent_string_table_lookup = true;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::Factory* factory = isolate->factory();
+  i::HandleScope scope(isolate);
+  LocalContext env;
+
+  i::Handle<i::String> existing =
+      factory->InternalizeUtf8String("alreadyInternalized");
+  i::Zone zone(isolate->allocator(), ZONE_NAME);
+
+  {
+    i::AstValueFactory avf(&zone, isolate->ast_string_constants(),
+                           isolate->heap()->HashSeed());
+    const i::AstRawString* hit = avf.GetOneByteString("alreadyInternalized");
+    const i::AstRawString* miss = avf.GetOneByteString("notYetInternalized");
+    avf.PrepareForConcurrentLookup(isolate->heap());
+    avf.LookupConcurrently();
+    avf.Internalize(isolate);
+    CHECK_EQ(*existing, *hit->string());
+    CHECK(miss->string()->IsInternalizedString());
+    CHECK(miss->string()->IsUtf8EqualTo(i::CStrVector("notYetInternalized")));
+    CHECK_EQ(1, avf.concurrent_lookup_hits());
+  }
+
+  {
+    // Entries found before a full GC are re-checked and still used.
+    i::AstValueFactory avf(&zone, isolate->ast_string_constants(),
+                           isolate->heap()->HashSeed());
+    const i::AstRawString* hit = avf.GetOneByteString("alreadyInternalized");
+    avf.PrepareForConcurrentLookup(isolate->heap());
+    avf.LookupConcurrently();
+    CcTest::CollectAllGarbage();
+    avf.Internalize(isolate);
+    CHECK_EQ(*existing, *hit->string());
+    CHECK_EQ(1, avf.concurrent_lookup_hits());
+  }
+
+  {
+    // A stale entry, e.g. after the table was grown, falls back to a lookup.
+    i::AstValueFactory avf(&zone, isolate->ast_string_constants(),
+                           isolate->heap()->HashSeed());
+    const i::AstRawString* hit = avf.GetOneByteString("alreadyInternalized");
+    avf.PrepareForConcurrentLookup(isolate->heap());
+    avf.LookupConcurrently();
+    i::Handle<i::StringTable> table = factory->string_table();
+    int capacity = table->Capacity();
+    for (int i = 0; table->Capacity() == capacity; i++) {
+      i::EmbeddedVector<char, 32> name;
+      i::SNPrintF(name, "growTheTable%d", i);
+      factory->InternalizeUtf8String(name.start());
+      table = factory->string_table();
+    }
+    avf.Internalize(isolate);
+    CHECK_EQ(*existing, *hit->string());
+  }
+}
+
+namespace {
+
+class ConcurrentLookupThread final : public v8::base::Thread {
+ public:
+  explicit ConcurrentLookupThread(i::AstValueFactory* avf)
+      : Thread(Options("ConcurrentLookupThread")), avf_(avf) {}
+
+  void Run() override {
+    i::DisallowHeapAllocation no_allocation;
+    i::DisallowHandleAllocation no_handles;
+    i::DisallowHandleDereference no_deref;
+    avf_->LookupConcurrently();
+  }
+
+ private:
+  i::AstValueFactory* avf_;
+};
+
+}  // namespace
+
+TEST(AstValueFactoryConcurrentLookupOnBackgroundThread) {
+  i::FLAG_concurrent_string_table_lookup = true;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::Factory* factory = isolate->factory();
+  i::HandleScope scope(isolate);
+  LocalContext env;
+
+  i::Handle<i::String> first = factory->InternalizeUtf8String("firstString");
+  i::Handle<i::String> second = factory->InternalizeUtf8String("secondString");
+  i::Zone zone(isolate->allocator(), ZONE_NAME);
+  i::AstValueFactory avf(&zone, isolate->ast_string_constants(),
+                         isolate->heap()->HashSeed());
+  const i::AstRawString* first_raw = avf.GetOneByteString("firstString");
+  const i::AstRawString* second_raw = avf.GetOneByteString("secondString");
+  avf.GetOneByteString("aStringThatIsNew");
+  avf.PrepareForConcurrentLookup(isolate->heap());
+
+  ConcurrentLookupThread thread(&avf);
+  thread.Start();
+  thread.Join();
+
+  avf.Internalize(isolate);
+  // Both existing strings were resolved on the background thread.
+  CHECK_EQ(2, avf.concurrent_lookup_hits());
+  CHECK_EQ(*first, *first_raw->string());
+  CHECK_EQ(*second, *second_raw->string());
+}
@@ -1901,6 +1901,94 @@ TEST(CodeSerializerIsolates) {
   isolate2->Dispose();
 }
 
+TEST(CodeSerializerAfterExecute) {
+  FLAG_serialize_toplevel = true;
+  FLAG_allow_natives_syntax = true;
+
+  const char* source =
+      "function f() { return 'abc'; };"
+      "f(); %OptimizeFunctionOnNextCall(f); f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kNoCompileOptions)
+            .ToLocalChecked();
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+
+    Handle<JSFunction> f = Handle<JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("f")));
+    CHECK_EQ(f->IsOptimized(), f->shared()->was_optimized());
+    if (f->IsOptimized()) {
+      cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+      CHECK_NOT_NULL(cache);
+    }
+  }
+  isolate1->Dispose();
+  // Nothing to check if optimization is disabled.
+  if (cache == nullptr) return;
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script;
+    {
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      script = v8::ScriptCompiler::CompileUnboundScript(
+                   isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+                   .ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+
+    // The lazily compiled function is in the cache and remembers that it was
+    // optimized.
+    Handle<SharedFunctionInfo> toplevel = Handle<SharedFunctionInfo>::cast(
+        v8::Utils::OpenHandle(*script));
+    bool found = false;
+    SharedFunctionInfo::ScriptIterator iter(
+        handle(Script::cast(toplevel->script())));
+    while (SharedFunctionInfo* shared = iter.Next()) {
+      if (shared == *toplevel) continue;
+      found = true;
+      CHECK(shared->is_compiled());
+      CHECK(shared->was_optimized());
+    }
+    CHECK(found);
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
 TEST(CodeSerializerFlagChange) {
   FLAG_serialize_toplevel = true;
 
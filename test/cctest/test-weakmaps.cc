@@ -126,6 +126,49 @@ TEST(Weakness) {
 }
 
 
+TEST(ChainedEphemerons) {
+  if (!FLAG_incremental_marking) return;
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  Handle<JSWeakMap> weakmap = AllocateJSWeakMap(isolate);
+  GlobalHandles* global_handles = isolate->global_handles();
+
+  // Put a chain of entries into the weak map, the value of each entry is the
+  // key of the next one. Only the first key is reachable from outside.
+  const int kLength = 100;
+  Handle<Object> key;
+  {
+    HandleScope scope(isolate);
+    Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    Handle<JSObject> object = factory->NewJSObjectFromMap(map);
+    key = global_handles->Create(*object);
+    for (int i = 0; i < kLength; i++) {
+      Handle<JSObject> value = factory->NewJSObjectFromMap(map);
+      int32_t hash = object->GetOrCreateHash(isolate)->value();
+      JSWeakCollection::Set(weakmap, object, value, hash);
+      object = value;
+    }
+  }
+  CHECK_EQ(kLength,
+           ObjectHashTable::cast(weakmap->table())->NumberOfElements());
+
+  // The whole chain is kept alive by incremental and concurrent marking.
+  heap::SimulateIncrementalMarking(heap);
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(kLength,
+           ObjectHashTable::cast(weakmap->table())->NumberOfElements());
+
+  // Without the first key the whole chain dies.
+  GlobalHandles::Destroy(key.location());
+  heap::SimulateIncrementalMarking(heap);
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(0, ObjectHashTable::cast(weakmap->table())->NumberOfElements());
+}
+
+
 TEST(Shrinking) {
   LocalContext context;
   Isolate* isolate = GetIsolateFrom(&context);
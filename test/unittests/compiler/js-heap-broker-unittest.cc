@@ -0,0 +1,116 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/js-heap-broker.h"
+#include "src/compilation-dependencies.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/isolate-inl.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class JSHeapBrokerTest : public GraphTest {
+ public:
+  JSHeapBrokerTest()
+      : GraphTest(1),
+        javascript_(zone()),
+        simplified_(zone()),
+        machine_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_),
+        broker_(isolate(), zone()) {}
+  ~JSHeapBrokerTest() override {}
+
+ protected:
+  void Serialize(Node* node) {
+    graph()->SetEnd(graph()->NewNode(common()->End(1), node));
+    broker()->SerializeGraph(&jsgraph_, zone());
+  }
+
+  JSHeapBroker* broker() { return &broker_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+  MachineOperatorBuilder machine_;
+  JSGraph jsgraph_;
+  JSHeapBroker broker_;
+};
+
+TEST_F(JSHeapBrokerTest, FunctionConstant) {
+  Handle<JSFunction> function = isolate()->object_function();
+  Handle<JSFunction> other = isolate()->array_function();
+  Serialize(HeapConstant(function));
+
+  JSHeapBroker::FunctionData data;
+  ASSERT_TRUE(broker()->GetFunctionData(function, &data));
+  SharedFunctionInfo* shared = function->shared();
+  EXPECT_EQ(shared->construct_stub(), *data.construct_stub);
+  EXPECT_EQ(shared->code()->builtin_index(), data.code_builtin_index);
+  EXPECT_EQ(shared->construct_stub()->builtin_index(),
+            data.construct_stub_builtin_index);
+  EXPECT_EQ(shared->internal_formal_parameter_count(),
+            data.formal_parameter_count);
+  EXPECT_EQ(shared->kind(), data.kind);
+  EXPECT_EQ(shared->language_mode(), data.language_mode);
+  EXPECT_EQ(shared->native(), data.native);
+  EXPECT_EQ(shared->HasBuiltinFunctionId(),
+            data.builtin_function_id != kInvalidBuiltinFunctionId);
+
+  EXPECT_FALSE(broker()->GetFunctionData(other, &data));
+}
+
+TEST_F(JSHeapBrokerTest, ContextConstant) {
+  Handle<Context> context = isolate()->native_context();
+  Serialize(HeapConstant(context));
+
+  Handle<JSObject> global_proxy;
+  ASSERT_TRUE(broker()->GetGlobalProxy(context).ToHandle(&global_proxy));
+  EXPECT_EQ(context->global_proxy(), *global_proxy);
+}
+
+TEST_F(JSHeapBrokerTest, StableMap) {
+  Handle<JSObject> object = factory()->NewJSObjectFromMap(
+      factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize));
+  Handle<JSObject> unstable = factory()->NewJSObjectFromMap(
+      factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize));
+  unstable->map()->mark_unstable();
+  Serialize(graph()->NewNode(common()->Merge(2), HeapConstant(object),
+                             HeapConstant(unstable)));
+
+  Handle<Map> map;
+  ASSERT_TRUE(broker()->GetStableMap(object).ToHandle(&map));
+  EXPECT_EQ(object->map(), *map);
+  EXPECT_TRUE(broker()->GetStableMap(unstable).is_null());
+}
+
+TEST_F(JSHeapBrokerTest, CommitDependencies) {
+  Handle<Map> map = factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+  ASSERT_TRUE(map->is_stable());
+  broker()->AssumeMapStable(map);
+
+  CompilationDependencies dependencies(isolate(), zone());
+  EXPECT_TRUE(broker()->CommitDependencies(&dependencies));
+  EXPECT_FALSE(dependencies.IsEmpty());
+  dependencies.Rollback();
+}
+
+TEST_F(JSHeapBrokerTest, CommitDependenciesAfterTransition) {
+  Handle<Map> map = factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+  broker()->AssumeMapStable(map);
+  map->mark_unstable();
+
+  CompilationDependencies dependencies(isolate(), zone());
+  EXPECT_FALSE(broker()->CommitDependencies(&dependencies));
+  EXPECT_TRUE(dependencies.IsEmpty());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
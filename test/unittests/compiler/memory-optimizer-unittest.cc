@@ -0,0 +1,87 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/memory-optimizer.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class MemoryOptimizerTest : public GraphTest {
+ public:
+  MemoryOptimizerTest()
+      : GraphTest(3),
+        machine_(zone()),
+        javascript_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+
+ protected:
+  Node* Allocate(Node* size, PretenureFlag pretenure, Node* effect) {
+    return graph()->NewNode(simplified()->Allocate(Type::Any(), pretenure),
+                            size, effect, graph()->start());
+  }
+
+  Node* StoreField(Node* object, Node* value, Node* effect) {
+    return graph()->NewNode(
+        simplified()->StoreField(AccessBuilder::ForFixedArraySlot(0)), object,
+        value, effect, graph()->start());
+  }
+
+  WriteBarrierKind Optimize(Node* store) {
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), store,
+                                 store, graph()->start());
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    MemoryOptimizer optimizer(jsgraph(), zone());
+    optimizer.Optimize();
+    EXPECT_EQ(IrOpcode::kStore, store->opcode());
+    return StoreRepresentationOf(store->op()).write_barrier_kind();
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+// -----------------------------------------------------------------------------
+// Write barrier elimination for pretenured allocations.
+
+TEST_F(MemoryOptimizerTest, StoreWithinTenuredGroupSkipsWriteBarrier) {
+  Node* object = Allocate(Int32Constant(16), TENURED, graph()->start());
+  Node* value = Allocate(Int32Constant(16), TENURED, object);
+  Node* store = StoreField(object, value, value);
+  EXPECT_EQ(kNoWriteBarrier, Optimize(store));
+}
+
+TEST_F(MemoryOptimizerTest, StoreAcrossTenuredGroupsKeepsWriteBarrier) {
+  // The dynamic size closes the allocation group of {object}, so {value}
+  // starts a new group.
+  Node* object = Allocate(Parameter(0), TENURED, graph()->start());
+  Node* value = Allocate(Int32Constant(16), TENURED, object);
+  Node* store = StoreField(object, value, value);
+  EXPECT_EQ(kFullWriteBarrier, Optimize(store));
+}
+
+TEST_F(MemoryOptimizerTest, StoreOfOutsideValueIntoTenuredKeepsWriteBarrier) {
+  // The {value} is not allocated by this graph and can be a young object.
+  Node* object = Allocate(Int32Constant(16), TENURED, graph()->start());
+  Node* value = Parameter(1);
+  Node* store = StoreField(object, value, object);
+  EXPECT_EQ(kFullWriteBarrier, Optimize(store));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -685,6 +685,83 @@ TEST_F(RegisterAllocatorTest, MultipleDeferredBlockSpills) {
             GetParallelMoveCount(start_of_b3, Instruction::START, sequence()));
 }
 
+TEST_F(RegisterAllocatorTest, FastModeSpillsAtDefinition) {
+  SaveFlags save_flags;
+  FLAG_turbo_fast_register_allocation_threshold = 1;
+
+  StartBlock();  // B0
+  auto var = EmitOI(Reg(0));
+  EndBlock(Branch(Reg(var), 1, 2));
+
+  StartBlock();  // B1
+  EndBlock(Jump(2));
+
+  StartBlock(true);  // B2
+  EmitCall(Slot(-1), Slot(var));
+  EndBlock();
+
+  StartBlock();  // B3
+  EmitNop();
+  EndBlock();
+
+  StartBlock();  // B4
+  Return(Reg(var, 0));
+  EndBlock();
+
+  Allocate();
+
+  // Deferred blocks are not splintered in the fast mode, so the value is
+  // spilled right after its definition rather than in the deferred block.
+  const int var_def_index = 1;
+  const int call_index = 3;
+  EXPECT_EQ(0,
+            GetParallelMoveCount(call_index, Instruction::START, sequence()));
+  EXPECT_TRUE(IsParallelMovePresent(var_def_index, Instruction::START,
+                                    sequence(), Reg(0), Slot(0)));
+}
+
+TEST_F(RegisterAllocatorTest, FastModePhisNeedTooManyRegisters) {
+  SaveFlags save_flags;
+  FLAG_turbo_fast_register_allocation_threshold = 1;
+  const size_t kNumRegs = 3;
+  const size_t kParams = kNumRegs + 1;
+  SetNumRegs(kNumRegs, kNumRegs);
+
+  StartBlock();
+  auto constant = DefineConstant();
+  VReg parameters[kParams];
+  for (size_t i = 0; i < arraysize(parameters); ++i) {
+    parameters[i] = DefineConstant();
+  }
+  EndBlock();
+
+  PhiInstruction* phis[kParams];
+  {
+    StartLoop(2);
+
+    StartBlock();
+    for (size_t i = 0; i < arraysize(parameters); ++i) {
+      phis[i] = Phi(parameters[i], 2);
+    }
+    for (size_t i = 0; i < arraysize(parameters); ++i) {
+      auto result = EmitOI(Same(), Reg(phis[i]), Use(constant));
+      SetInput(phis[i], 1, result);
+    }
+    EndBlock(Branch(Reg(DefineConstant()), 1, 2));
+
+    StartBlock();
+    EndBlock(Jump(-1));
+
+    EndLoop();
+  }
+
+  StartBlock();
+  Return(DefineConstant());
+  EndBlock();
+
+  Allocate();
+}
+
 namespace {
 
 enum class ParameterType { kFixedSlot, kSlot, kRegister, kFixedRegister };
@@ -0,0 +1,51 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/gc-latency-scheduler.h"
+#include "src/heap/gc-idle-time-handler.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+TEST(GCLatencyScheduler, EstimateMarkingWallTime) {
+  // Marking 100 MB at 1 MB/ms takes 100 ms of collector time, which is a
+  // quarter of the wall time at a mutator utilization of 0.75.
+  EXPECT_DOUBLE_EQ(400.0, GCLatencyScheduler::EstimateMarkingWallTime(
+                              100 * MB, 1 * MB, 0.75));
+}
+
+TEST(GCLatencyScheduler, EstimateMarkingWallTimeInitialSpeed) {
+  const size_t live_bytes = 10 * MB;
+  EXPECT_DOUBLE_EQ(
+      static_cast<double>(live_bytes) /
+          (GCIdleTimeHandler::kInitialConservativeMarkingSpeed * 0.5),
+      GCLatencyScheduler::EstimateMarkingWallTime(live_bytes, 0, 0.5));
+}
+
+TEST(GCLatencyScheduler, ShouldStartMarking) {
+  // 400 ms of wall time, 300 ms of which are spent in the mutator allocating
+  // 100 KB/ms, i.e. 30000 KB are allocated while marking.
+  const double kAllocationThroughput = 100 * KB;
+  EXPECT_TRUE(GCLatencyScheduler::ShouldStartMarking(
+      29000 * KB, 100 * MB, 1 * MB, kAllocationThroughput, 0.75));
+  EXPECT_FALSE(GCLatencyScheduler::ShouldStartMarking(
+      31000 * KB, 100 * MB, 1 * MB, kAllocationThroughput, 0.75));
+}
+
+TEST(GCLatencyScheduler, ShouldStartMarkingNoAllocation) {
+  EXPECT_FALSE(
+      GCLatencyScheduler::ShouldStartMarking(0, 100 * MB, 1 * MB, 0, 0.75));
+}
+
+TEST(GCLatencyScheduler, HigherUtilizationStartsEarlier) {
+  const size_t available = 20 * MB;
+  EXPECT_FALSE(GCLatencyScheduler::ShouldStartMarking(
+      available, 100 * MB, 1 * MB, 100 * KB, 0.5));
+  EXPECT_TRUE(GCLatencyScheduler::ShouldStartMarking(
+      available, 100 * MB, 1 * MB, 100 * KB, 0.9));
+}
+
+}  // namespace internal
+}  // namespace v8
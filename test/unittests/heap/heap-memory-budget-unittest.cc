@@ -0,0 +1,35 @@
+// Copyright 2017 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-memory-budget.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+TEST(HeapMemoryBudget, StageForUsageWithoutBudget) {
+  EXPECT_EQ(HeapMemoryBudget::kWithinBudget,
+            HeapMemoryBudget::StageForUsage(100 * MB, 0));
+}
+
+TEST(HeapMemoryBudget, StageForUsage) {
+  const size_t kBudget = 100 * MB;
+  EXPECT_EQ(HeapMemoryBudget::kWithinBudget,
+            HeapMemoryBudget::StageForUsage(0, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kWithinBudget,
+            HeapMemoryBudget::StageForUsage(69 * MB, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kReduceMemory,
+            HeapMemoryBudget::StageForUsage(70 * MB, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kFlushCaches,
+            HeapMemoryBudget::StageForUsage(85 * MB, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kDeoptimize,
+            HeapMemoryBudget::StageForUsage(95 * MB, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kDeoptimize,
+            HeapMemoryBudget::StageForUsage(kBudget, kBudget));
+  EXPECT_EQ(HeapMemoryBudget::kExceeded,
+            HeapMemoryBudget::StageForUsage(kBudget + 1, kBudget));
+}
+
+}  // namespace internal
+}  // namespace v8
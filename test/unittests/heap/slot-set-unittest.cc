@@ -44,6 +44,23 @@ TEST(SlotSet, InsertAndLookup2) {
   }
 }
 
+TEST(SlotSet, InsertCell) {
+  SlotSet set;
+  set.SetPageStart(0);
+  const int kCellSize = SlotSet::kBitsPerCell * kPointerSize;
+  for (int cell = 0; cell < Page::kPageSize; cell += kCellSize) {
+    set.InsertCell(cell, 0x80000005u);
+  }
+  for (int i = 0; i < Page::kPageSize; i += kPointerSize) {
+    int bit = (i % kCellSize) / kPointerSize;
+    if (bit == 0 || bit == 2 || bit == SlotSet::kBitsPerCell - 1) {
+      EXPECT_TRUE(set.Lookup(i));
+    } else {
+      EXPECT_FALSE(set.Lookup(i));
+    }
+  }
+}
+
 TEST(SlotSet, Iterate) {
   SlotSet set;
   set.SetPageStart(0);
@@ -82,5 +82,44 @@ TEST_F(SequentialUnmapperTest, UnmapOnTeardown) {
 
 #endif  // __linux__
 
+TEST_F(SequentialUnmapperTest, PoolSizeForAllocationRate) {
+  const size_t kMaxChunks = 16;
+  EXPECT_EQ(0u, MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+                    0, kMaxChunks));
+  // A single byte allocated in the window keeps a page around.
+  EXPECT_EQ(1u, MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+                    1, kMaxChunks));
+  const double one_page_per_window =
+      static_cast<double>(Page::kPageSize) /
+      MemoryAllocator::Unmapper::kPoolAllocationWindowMs;
+  EXPECT_EQ(4u, MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+                    4 * one_page_per_window, kMaxChunks));
+  EXPECT_EQ(kMaxChunks, MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+                            1000 * one_page_per_window, kMaxChunks));
+  EXPECT_EQ(0u, MemoryAllocator::Unmapper::PoolSizeForAllocationRate(
+                    1000 * one_page_per_window, 0));
+}
+
+TEST_F(SequentialUnmapperTest, ReusePooledPage) {
+  PagedSpace* old_space = static_cast<PagedSpace*>(heap()->old_space());
+  Page* page = allocator()->AllocatePage(
+      MemoryAllocator::PageAreaSize(OLD_SPACE), old_space,
+      Executability::NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, page);
+  Address address = page->address();
+  const size_t pooled_chunks = unmapper()->NumberOfPooledChunks();
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  unmapper()->FreeQueuedChunks();
+  EXPECT_EQ(pooled_chunks + 1, unmapper()->NumberOfPooledChunks());
+  Page* reused = allocator()->AllocatePage<MemoryAllocator::kPooled>(
+      MemoryAllocator::PageAreaSize(OLD_SPACE), old_space,
+      Executability::NOT_EXECUTABLE);
+  EXPECT_EQ(address, reused->address());
+  EXPECT_EQ(pooled_chunks, unmapper()->NumberOfPooledChunks());
+  // The memory of the page is accessible again.
+  Memory::Address_at(reused->area_start()) = nullptr;
+  allocator()->Free<MemoryAllocator::kFull>(reused);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -317,6 +317,26 @@ TEST(Bytecodes, IsJumpIfToBoolean) {
 #undef TEST_BYTECODE
 }
 
+TEST(Bytecodes, IsJumpIfLookahead) {
+  EXPECT_TRUE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestLessThan,
+                                           OperandScale::kSingle));
+  EXPECT_FALSE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestLessThan,
+                                            OperandScale::kDouble));
+  EXPECT_FALSE(
+      Bytecodes::IsJumpIfLookahead(Bytecode::kAdd, OperandScale::kSingle));
+
+#define TEST_BYTECODE(Name, ...)                                         \
+  if (Bytecodes::IsJumpIfLookahead(Bytecode::k##Name,                    \
+                                   OperandScale::kSingle)) {             \
+    EXPECT_TRUE(Bytecodes::WritesAccumulator(Bytecode::k##Name));        \
+    EXPECT_FALSE(Bytecodes::IsStarLookahead(Bytecode::k##Name,           \
+                                            OperandScale::kSingle));     \
+  }
+
+  BYTECODE_LIST(TEST_BYTECODE)
+#undef TEST_BYTECODE
+}
+
 #undef OR_IS_BYTECODE
 #undef IN_BYTECODE_LIST
 
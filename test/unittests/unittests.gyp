@@ -66,6 +66,7 @@
       'compiler/int64-lowering-unittest.cc',
       'compiler/js-builtin-reducer-unittest.cc',
       'compiler/js-create-lowering-unittest.cc',
+      'compiler/js-heap-broker-unittest.cc',
       'compiler/js-intrinsic-lowering-unittest.cc',
       'compiler/js-operator-unittest.cc',
       'compiler/js-typed-lowering-unittest.cc',
@@ -76,6 +77,7 @@
       'compiler/loop-peeling-unittest.cc',
       'compiler/machine-operator-reducer-unittest.cc',
       'compiler/machine-operator-unittest.cc',
+      'compiler/memory-optimizer-unittest.cc',
       'compiler/regalloc/move-optimizer-unittest.cc',
       'compiler/node-cache-unittest.cc',
       'compiler/node-matchers-unittest.cc',
@@ -107,7 +109,9 @@
       'heap/bitmap-unittest.cc',
       'heap/embedder-tracing-unittest.cc',
       'heap/gc-idle-time-handler-unittest.cc',
+      'heap/gc-latency-scheduler-unittest.cc',
       'heap/gc-tracer-unittest.cc',
+      'heap/heap-memory-budget-unittest.cc',
       'heap/item-parallel-job-unittest.cc',
       'heap/marking-unittest.cc',
       'heap/memory-reducer-unittest.cc',